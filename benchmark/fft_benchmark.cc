@@ -0,0 +1,124 @@
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+#include "fft_backend.h"
+#include "fft_plan.h"
+#include "numeric_utils.h"
+
+/**
+ * Benchmark of available FFT backends. For each transform length the time per
+ * real-to-complex and complex-to-real round trip is reported for every
+ * backend along with the fastest backend, which can then be selected through
+ * the SMELT_FFT_BACKEND environment variable or numeric_utils::set_fft_backend.
+ * Usage: fft_benchmark [minimum seconds per measurement]
+ */
+namespace {
+/**
+ * Repeat task until minimum time has elapsed
+ * @param[in] task Task to time
+ * @param[in] min_seconds Minimum total time to run task for
+ * @return Average time per call in microseconds
+ */
+template <typename Task>
+double time_task(Task task, double min_seconds) {
+  // Warm up, which also commits plans
+  task();
+
+  std::size_t repetitions = 0;
+  double elapsed = 0.0;
+  auto start = std::chrono::steady_clock::now();
+  while (elapsed < min_seconds) {
+    task();
+    ++repetitions;
+    elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                            start)
+                  .count();
+  }
+
+  return 1.0e6 * elapsed / static_cast<double>(repetitions);
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  double min_seconds = argc > 1 ? std::atof(argv[1]) : 0.25;
+
+  // Include fast lengths, a typical record length and a prime length
+  std::vector<std::size_t> lengths = {1024, 4000, 4096, 6000, 16384, 65536,
+                                      100003};
+  auto backends = numeric_utils::fft_backends();
+
+  std::cout << std::setw(26) << "task";
+  for (const auto& backend : backends) {
+    std::cout << std::setw(14) << backend + " (us)";
+  }
+  std::cout << std::setw(12) << "fastest" << std::endl;
+
+  std::map<std::string, unsigned int> wins;
+  auto report = [&](const std::string& label,
+                    const std::vector<double>& times) {
+    std::size_t best = 0;
+    std::cout << std::setw(26) << label;
+    for (std::size_t i = 0; i < times.size(); ++i) {
+      std::cout << std::setw(14) << std::fixed << std::setprecision(2)
+                << times[i];
+      if (times[i] < times[best]) {
+        best = i;
+      }
+    }
+    std::cout << std::setw(12) << backends[best] << std::endl;
+    ++wins[backends[best]];
+  };
+
+  for (auto length : lengths) {
+    std::vector<double> signal(length);
+    for (std::size_t i = 0; i < length; ++i) {
+      signal[i] = std::sin(0.01 * i) + 0.5 * std::cos(0.37 * i);
+    }
+    std::vector<std::complex<double>> spectrum(length / 2 + 1);
+    std::vector<double> output(length);
+
+    std::vector<double> times;
+    for (const auto& backend : backends) {
+      numeric_utils::set_fft_backend(backend);
+      times.push_back(time_task(
+          [&]() {
+            numeric_utils::fft_r2c(signal.data(), spectrum.data(), length);
+            numeric_utils::inverse_fft_c2r(spectrum.data(), output.data(),
+                                           length);
+          },
+          min_seconds));
+    }
+    report("round trip N=" + std::to_string(length), times);
+  }
+
+  // Direct convolution with a short kernel, as used for filtering
+  std::vector<double> record(20000, 1.0), kernel(32, 0.5), response;
+  std::vector<double> times;
+  for (const auto& backend : backends) {
+    numeric_utils::set_fft_backend(backend);
+    times.push_back(time_task(
+        [&]() {
+          numeric_utils::convolve_1d(record, kernel, response,
+                                     numeric_utils::ConvolutionMode::Direct);
+        },
+        min_seconds));
+  }
+  report("direct conv 20000x32", times);
+
+  std::string fastest = backends.front();
+  for (const auto& backend : backends) {
+    if (wins[backend] > wins[fastest]) {
+      fastest = backend;
+    }
+  }
+  std::cout << "\nFastest backend on this host: " << fastest
+            << "\nSelect it with SMELT_FFT_BACKEND=" << fastest << std::endl;
+
+  return 0;
+}
@@ -9,12 +9,11 @@ class smeltConan(ConanFile):
     author = "Michael Gardner mhgardner@berkeley.edu"
     url = "https://github.com/NHERI-SimCenter/smelt"
     settings = {"os": None, "build_type": None, "compiler": None, "arch": ["x86_64"]}
-    options = {"shared": [True, False]}
-    default_options = {"shared": False}
+    options = {"shared": [True, False], "mkl_fft": [True, False]}
+    default_options = {"shared": False, "mkl_fft": True}
     generators = "cmake"
     build_policy = "missing"
-    requires = "mkl-include/2019.4@simcenter/stable", \
-               "ipp-include/2019.4@simcenter/stable", \
+    requires = "ipp-include/2019.4@simcenter/stable", \
                "eigen/3.3.7@conan/stable", \
                "clara/1.1.5@bincrafters/stable", \
                "jsonformoderncpp/3.7.0@vthiery/stable", \
@@ -39,17 +38,24 @@ class smeltConan(ConanFile):
     def configure(self):
         self.options["boost"].header_only = True            
 
+    def requirements(self):
+        # MKL is only needed for the MKL FFT backend
+        if self.options.mkl_fft:
+            self.requires("mkl-include/2019.4@simcenter/stable")
+
     def build_requirements(self):
         if self.options.shared:
-            self.build_requires("mkl-shared/2019.4@simcenter/stable")
+            if self.options.mkl_fft:
+                self.build_requires("mkl-shared/2019.4@simcenter/stable")
+                self.default_options.update({"mkl-shared:single_lib": True})
             self.build_requires("ipp-shared/2019.4@simcenter/stable")
-            self.default_options.update({"mkl-shared:single_lib": True})
             self.default_options.update({"ipp-shared:signal_and_vector_math": True})
             # self.build_requires("intel-openmp/2019.4@simcenter/stable")
         else:
-            self.build_requires("mkl-static/2019.4@simcenter/stable")
+            if self.options.mkl_fft:
+                self.build_requires("mkl-static/2019.4@simcenter/stable")
+                self.default_options.update({"mkl-static:threaded": False})            
             self.build_requires("ipp-static/2019.4@simcenter/stable")
-            self.default_options.update({"mkl-static:threaded": False})            
             
     def configure_cmake(self):
         cmake = CMake(self, msbuild_verbosity='detailed')
@@ -63,6 +69,8 @@ class smeltConan(ConanFile):
             cmake.definitions["BUILD_SHARED_LIBS"] = "OFF"
             cmake.definitions["BUILD_STATIC_LIBS"] = "ON"
 
+        cmake.definitions["USE_MKL_FFT"] = "ON" if self.options.mkl_fft else "OFF"
+
         cmake.configure(source_folder=self._source_subfolder)
         return cmake
     
@@ -0,0 +1,174 @@
+#ifndef _BASELINE_FITTER_H_
+#define _BASELINE_FITTER_H_
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <Eigen/Dense>
+
+namespace numeric_utils {
+
+/**
+ * Least-squares fitter of zero-intercept polynomials with terms of degree 2
+ * through the fit degree to records sampled on a uniform time grid. This is
+ * the same fit computed by polyfit_intercept with zero intercept. Time is
+ * scaled to the unit interval and the scaled basis is orthonormalized on the
+ * grid with a QR decomposition on construction, giving a discrete orthogonal
+ * polynomial basis that remains well conditioned for long records. Fitting
+ * any number of records then only requires two matrix products.
+ */
+class BaselineFitter {
+ public:
+  /**
+   * @constructor Prepare fit for records of given length and time step
+   * @param[in] num_points Number of samples in each record
+   * @param[in] time_step Time step between samples. The first sample is at
+   *                      time zero.
+   * @param[in] degree Degree of fitted polynomial. Must be at least 2.
+   */
+  BaselineFitter(std::size_t num_points, double time_step,
+                 unsigned int degree);
+
+  /**
+   * @destructor Virtual destructor
+   */
+  virtual ~BaselineFitter() {};
+
+  /**
+   * Delete copy constructor
+   */
+  BaselineFitter(const BaselineFitter&) = delete;
+
+  /**
+   * Delete assignment operator
+   */
+  BaselineFitter& operator=(const BaselineFitter&) = delete;
+
+  /**
+   * Fit polynomial to each record
+   * @param[in] data Matrix with one record of num_points() samples per column
+   * @return Matrix where each column contains degree() + 1 coefficients of the
+   *         fitted polynomial for the corresponding record ordered in
+   *         descending power, with zero linear and constant terms
+   */
+  Eigen::MatrixXd fit(const Eigen::MatrixXd& data) const;
+
+  /**
+   * Evaluate derivative of fitted polynomial on the time grid for each record
+   * without forming monomial coefficients
+   * @param[in] data Matrix with one record of num_points() samples per column
+   * @param[in] derivative Order of derivative to evaluate. Defaults to 0, in
+   *                       which case the fitted polynomials are evaluated.
+   * @return Matrix with num_points() rows and one column per record
+   */
+  Eigen::MatrixXd evaluate(const Eigen::MatrixXd& data,
+                           unsigned int derivative = 0) const;
+
+  /**
+   * Get the number of samples in each record
+   * @return Number of samples
+   */
+  std::size_t num_points() const { return num_points_; }
+
+  /**
+   * Get the time step between samples
+   * @return Time step
+   */
+  double time_step() const { return time_step_; }
+
+  /**
+   * Get the degree of fitted polynomials
+   * @return Polynomial degree
+   */
+  unsigned int degree() const { return degree_; }
+
+ private:
+  std::size_t num_points_; /**< Number of samples in each record */
+  double time_step_; /**< Time step between samples */
+  unsigned int degree_; /**< Degree of fitted polynomial */
+  double time_scale_; /**< Duration used to scale time to unit interval */
+  Eigen::MatrixXd projection_; /**< Transpose of orthonormal basis on grid */
+  Eigen::MatrixXd triangular_; /**< Upper triangular factor of scaled basis */
+};
+
+/**
+ * Singleton, thread-safe cache of baseline fitters keyed on record length,
+ * time step and degree. The cache holds at most capacity() fitters and evicts
+ * the least recently used fitter when full. Evicted fitters remain valid for
+ * as long as a caller holds on to them.
+ */
+class BaselineFitterCache {
+ public:
+  /**
+   * Get the single instance of the fitter cache
+   */
+  static BaselineFitterCache* instance() {
+    static BaselineFitterCache cache;
+    return &cache;
+  }
+
+  /**
+   * Get fitter matching input configuration, creating a new one if it is not
+   * already cached
+   * @param[in] num_points Number of samples in each record
+   * @param[in] time_step Time step between samples
+   * @param[in] degree Degree of fitted polynomial
+   * @return Shared pointer to fitter
+   */
+  std::shared_ptr<const BaselineFitter> fitter(std::size_t num_points,
+                                               double time_step,
+                                               unsigned int degree);
+
+  /**
+   * Set the maximum number of fitters held by the cache. Least recently used
+   * fitters are evicted if the cache currently holds more than this.
+   * @param[in] capacity Maximum number of cached fitters
+   */
+  void set_capacity(std::size_t capacity);
+
+  /**
+   * Get the maximum number of fitters held by the cache
+   * @return Maximum number of cached fitters
+   */
+  std::size_t capacity() const;
+
+  /**
+   * Get the number of fitters currently cached
+   * @return Number of cached fitters
+   */
+  std::size_t size() const;
+
+  /**
+   * Remove all fitters from cache
+   */
+  void clear();
+
+ private:
+  /**
+   * Private constructor
+   */
+  BaselineFitterCache() = default;
+
+  /**
+   * Evict least recently used fitters until cache size is within capacity.
+   * Caller must hold the cache mutex.
+   */
+  void trim();
+
+  typedef std::tuple<std::size_t, double, unsigned int>
+      FitterKey; /**< Cache key */
+  typedef std::list<std::pair<FitterKey, std::shared_ptr<const BaselineFitter>>>
+      FitterList; /**< Fitters ordered from most to least recently used */
+
+  mutable std::mutex mutex_; /**< Mutex guarding cache state */
+  std::size_t capacity_ = 64; /**< Maximum number of cached fitters */
+  FitterList fitters_; /**< Cached fitters in order of use */
+  std::map<FitterKey, FitterList::iterator>
+      lookup_; /**< Map from key to fitter */
+};
+}  // namespace numeric_utils
+
+#endif  // _BASELINE_FITTER_H_
@@ -57,6 +57,21 @@ class BetaDistribution : public Distribution {
       const std::vector<double>& probabilities) const override;
 
  protected:
+  /**
+   * Transform single value from standard normal space to the distribution by
+   * evaluating the quantile function
+   * @param[in] value Value in standard normal space
+   * @return Transformed value
+   */
+  double transform_exact(double value) const override;
+
+  /**
+   * Evaluate the probability density function of the distribution
+   * @param[in] location Location at which to evaluate PDF
+   * @return Value of PDF at input location
+   */
+  double density(double location) const override;
+
   double alpha_;    /**< Shape parameter */
   double beta_; /**< Shape parameter */
   boost::math::beta_distribution<double>
@@ -0,0 +1,88 @@
+#ifndef _CHIRP_Z_TRANSFORM_H_
+#define _CHIRP_Z_TRANSFORM_H_
+
+#include <complex>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "fft_plan.h"
+
+namespace numeric_utils {
+
+/**
+ * Chirp-z transform prepared for repeated evaluation. Computes sums of the
+ * form
+ *   output[m] = sum_j input[j] * exp(i * angle_step * j * m)
+ * for arbitrary angle step using Bluestein's algorithm, so the sum is
+ * evaluated with FFTs even when angle_step is not a multiple of 2 pi / N.
+ * The transform of the chirp is computed once on construction so that each
+ * subsequent evaluation costs one forward and one backward complex FFT.
+ */
+class ChirpZTransform {
+ public:
+  /**
+   * @constructor Prepare chirp-z transform
+   * @param[in] num_inputs Number of input coefficients
+   * @param[in] num_outputs Number of output values
+   * @param[in] angle_step Angle increment in radians between consecutive
+   *                       products of input and output indices
+   */
+  ChirpZTransform(std::size_t num_inputs, std::size_t num_outputs,
+                  double angle_step);
+
+  /**
+   * @destructor Virtual destructor
+   */
+  virtual ~ChirpZTransform() {};
+
+  /**
+   * Delete copy constructor
+   */
+  ChirpZTransform(const ChirpZTransform&) = delete;
+
+  /**
+   * Delete assignment operator
+   */
+  ChirpZTransform& operator=(const ChirpZTransform&) = delete;
+
+  /**
+   * Evaluate the transform
+   * @param[in] input Pointer to num_inputs() input coefficients
+   * @param[in, out] output Pointer to location to write num_outputs() values
+   *                        to
+   */
+  void execute(const std::complex<double>* input,
+               std::complex<double>* output) const;
+
+  /**
+   * Get the number of input coefficients
+   * @return Number of inputs
+   */
+  std::size_t num_inputs() const { return num_inputs_; }
+
+  /**
+   * Get the number of output values
+   * @return Number of outputs
+   */
+  std::size_t num_outputs() const { return num_outputs_; }
+
+  /**
+   * Get the length of transforms used for evaluation
+   * @return Transform length
+   */
+  std::size_t fft_length() const { return fft_length_; }
+
+ private:
+  std::size_t num_inputs_; /**< Number of input coefficients */
+  std::size_t num_outputs_; /**< Number of output values */
+  std::size_t fft_length_; /**< Length of transforms */
+  std::vector<std::complex<double>>
+      chirp_; /**< Chirp exp(i * angle_step * k^2 / 2) for each index */
+  std::vector<std::complex<double>>
+      chirp_spectrum_; /**< Spectrum of wrapped conjugate chirp */
+  std::shared_ptr<const FftPlan> forward_plan_; /**< Forward complex plan */
+  std::shared_ptr<const FftPlan> backward_plan_; /**< Backward complex plan */
+};
+}  // namespace numeric_utils
+
+#endif  // _CHIRP_Z_TRANSFORM_H_
@@ -0,0 +1,92 @@
+#ifndef _CONVOLUTION_KERNEL_H_
+#define _CONVOLUTION_KERNEL_H_
+
+#include <complex>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "fft_plan.h"
+
+namespace numeric_utils {
+
+/**
+ * Convolution kernel prepared for repeated FFT-based convolution. The Fourier
+ * transform of the kernel is computed once on construction so that each
+ * subsequent convolution only requires transforming the input signal. Inputs
+ * longer than the block size are processed using the overlap-add method, so
+ * the transform length stays fixed regardless of record length.
+ * @tparam T Floating point type of kernel, inputs and transforms
+ */
+template <typename T>
+class BasicConvolutionKernel {
+ public:
+  /**
+   * @constructor Prepare kernel for convolution
+   * @param[in] kernel Kernel values, such as a filter impulse response
+   * @param[in] block_size Number of input samples to process per transform.
+   *                       Inputs no longer than this are convolved with a
+   *                       single transform. Defaults to 0, in which case the
+   *                       block size is chosen based on the kernel length.
+   */
+  explicit BasicConvolutionKernel(const std::vector<T>& kernel,
+                                  std::size_t block_size = 0);
+
+  /**
+   * @destructor Virtual destructor
+   */
+  virtual ~BasicConvolutionKernel() {};
+
+  /**
+   * Delete copy constructor
+   */
+  BasicConvolutionKernel(const BasicConvolutionKernel&) = delete;
+
+  /**
+   * Delete assignment operator
+   */
+  BasicConvolutionKernel& operator=(const BasicConvolutionKernel&) = delete;
+
+  /**
+   * Compute the full 1-dimensional convolution of the input with the kernel
+   * @param[in] input Input signal
+   * @param[in, out] response Vector to store convolution results to. Resized
+   *                          to input.size() + size() - 1.
+   * @return Returns true if convolution was successful, false otherwise
+   */
+  bool convolve(const std::vector<T>& input, std::vector<T>& response) const;
+
+  /**
+   * Get the number of values in kernel
+   * @return Kernel length
+   */
+  std::size_t size() const { return kernel_size_; }
+
+  /**
+   * Get the number of input samples processed per transform
+   * @return Block size
+   */
+  std::size_t block_size() const { return block_size_; }
+
+  /**
+   * Get the length of transforms used for convolution
+   * @return Transform length
+   */
+  std::size_t fft_length() const { return fft_length_; }
+
+ private:
+  std::size_t kernel_size_; /**< Number of values in kernel */
+  std::size_t block_size_; /**< Input samples processed per transform */
+  std::size_t fft_length_; /**< Length of transforms */
+  std::vector<std::complex<T>>
+      kernel_spectrum_; /**< Half spectrum of zero-padded kernel */
+  std::shared_ptr<const FftPlan> forward_plan_; /**< Real-to-complex plan */
+  std::shared_ptr<const FftPlan> backward_plan_; /**< Complex-to-real plan */
+};
+
+/**
+ * Double precision convolution kernel
+ */
+typedef BasicConvolutionKernel<double> ConvolutionKernel;
+}  // namespace numeric_utils
+
+#endif  // _CONVOLUTION_KERNEL_H_
@@ -1,11 +1,25 @@
 #ifndef _DISTRIBUTION_H_
 #define _DISTRIBUTION_H_
 
+#define _USE_MATH_DEFINES
+#include <cmath>
+#include <limits>
+#include <memory>
 #include <string>
 #include <vector>
+#include <Eigen/Dense>
 
 namespace stochastic {
 
+class QuantileTable;
+
+/**
+ * Reference to matrix, column, row or block of values transformed in place
+ */
+typedef Eigen::Ref<Eigen::MatrixXd, 0,
+                   Eigen::Stride<Eigen::Dynamic, Eigen::Dynamic>>
+    ValuesRef;
+
 /**
  * Abstract base class for distribution models
  */
@@ -22,7 +36,8 @@ class Distribution {
   virtual ~Distribution(){};
 
   /**
-   * Delete copy constructor
+   * Delete copy constructor, since quantile tables refer to the
+   * distribution they were built for
    */
   Distribution(const Distribution&) = delete;
 
@@ -55,6 +70,79 @@ class Distribution {
    */
   virtual std::vector<double> inv_cumulative_dist_func(
       const std::vector<double>& probabilities) const = 0;
+
+  /**
+   * Transform values from standard normal space to the distribution in place,
+   * evaluating the ICDF at the standard normal CDF of each value. Does not
+   * allocate, so entire matrices of parameter realizations can be
+   * transformed in a single call. Default implementation uses the quantile
+   * table if one has been built and transform_exact otherwise.
+   * @param[in, out] values Values in standard normal space, which are
+   *                        overwritten with the transformed values
+   */
+  virtual void transform_from_std_normal(ValuesRef values) const;
+
+  /**
+   * Precompute table for transforming values from standard normal space, so
+   * that subsequent transformations do not evaluate the quantile function
+   * iteratively. Tables are built from transform_exact and density, so
+   * distributions that do not provide them, such as those whose
+   * transformation has a closed form, do not use tables.
+   * @param[in] tolerance Maximum interpolation error of table, relative to
+   *                      the magnitude of transformed values when larger
+   *                      than 1
+   * @return True if subsequent transformations use a table, false otherwise
+   */
+  bool build_quantile_table(double tolerance = 1.0e-9);
+
+ protected:
+  /**
+   * Transform single value from standard normal space to the distribution by
+   * evaluating the quantile function. Default implementation returns NaN.
+   * @param[in] value Value in standard normal space
+   * @return Transformed value
+   */
+  virtual double transform_exact(double /*value*/) const {
+    return std::numeric_limits<double>::quiet_NaN();
+  };
+
+  /**
+   * Evaluate the probability density function of the distribution. Default
+   * implementation returns NaN.
+   * @param[in] location Location at which to evaluate PDF
+   * @return Value of PDF at input location
+   */
+  virtual double density(double /*location*/) const {
+    return std::numeric_limits<double>::quiet_NaN();
+  };
+
+  /**
+   * Evaluate quantile of Boost distribution at the standard normal CDF of a
+   * value. The complement is used for positive values to keep precision in
+   * the upper tail.
+   * @tparam T Type of Boost distribution
+   * @param[in] distribution Boost distribution
+   * @param[in] value Value in standard normal space
+   * @return Quantile of distribution
+   */
+  template <typename T>
+  static double std_normal_quantile(const T& distribution, double value) {
+    return value > 0.0
+               ? quantile(complement(distribution, std_normal_cdf(-value)))
+               : quantile(distribution, std_normal_cdf(value));
+  };
+
+  /**
+   * Evaluate the standard normal cumulative distribution function
+   * @param[in] location Location at which to evaluate CDF
+   * @return Value of CDF at input location
+   */
+  static double std_normal_cdf(double location) {
+    return 0.5 * std::erfc(-location * M_SQRT1_2);
+  };
+
+  std::shared_ptr<QuantileTable>
+      quantile_table_; /**< Table used for transformation, if built */
 };
 }  // namespace stochastic
 
@@ -0,0 +1,240 @@
+#ifndef _FFT_BACKEND_H_
+#define _FFT_BACKEND_H_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace numeric_utils {
+
+/**
+ * Direction of Fourier transform
+ */
+enum class FftDirection { Forward, Backward };
+
+/**
+ * Domain of forward transform input. Real domain transforms are real to
+ * conjugate-even complex in the forward direction and the reverse in the
+ * backward direction.
+ */
+enum class FftDomain { Real, Complex };
+
+/**
+ * Floating point precision of transform
+ */
+enum class FftPrecision { Single, Double };
+
+/**
+ * Transform precision matching floating point type
+ * @tparam T Floating point type
+ */
+template <typename T>
+struct FftPrecisionOf;
+
+/**
+ * Transform precision for single precision values
+ */
+template <>
+struct FftPrecisionOf<float> {
+  static constexpr FftPrecision value = FftPrecision::Single;
+};
+
+/**
+ * Transform precision for double precision values
+ */
+template <>
+struct FftPrecisionOf<double> {
+  static constexpr FftPrecision value = FftPrecision::Double;
+};
+
+/**
+ * Layout of one or more equal-length signals stored in a single buffer.
+ * Strides are the spacing between consecutive elements of a signal and
+ * distances are the spacing between the first elements of consecutive
+ * signals. Both are in units of the input or output element type, where the
+ * complex side of real domain transforms is counted in complex values.
+ * In-place transforms overwrite their input with the output. For in-place
+ * real domain transforms the real buffer must hold 2 * (N / 2 + 1) values
+ * per signal so the half spectrum fits.
+ */
+struct FftLayout {
+  /**
+   * @constructor Construct layout. Defaults to a single contiguous signal.
+   * @param[in] num_transforms Number of signals in buffer
+   * @param[in] input_stride Spacing between input signal elements
+   * @param[in] input_distance Spacing between consecutive input signals
+   * @param[in] output_stride Spacing between output signal elements
+   * @param[in] output_distance Spacing between consecutive output signals
+   * @param[in] in_place Indicates that output overwrites input
+   */
+  FftLayout(std::size_t num_transforms = 1, std::size_t input_stride = 1,
+            std::size_t input_distance = 0, std::size_t output_stride = 1,
+            std::size_t output_distance = 0, bool in_place = false)
+      : num_transforms{num_transforms},
+        input_stride{input_stride},
+        input_distance{input_distance},
+        output_stride{output_stride},
+        output_distance{output_distance},
+        in_place{in_place} {}
+
+  /**
+   * Get tuple of layout values for ordering and comparison
+   * @return Tuple containing layout values
+   */
+  std::tuple<std::size_t, std::size_t, std::size_t, std::size_t, std::size_t,
+             bool>
+      as_tuple() const {
+    return std::make_tuple(num_transforms, input_stride, input_distance,
+                           output_stride, output_distance, in_place);
+  }
+
+  std::size_t num_transforms; /**< Number of signals */
+  std::size_t input_stride; /**< Spacing between input elements */
+  std::size_t input_distance; /**< Spacing between input signals */
+  std::size_t output_stride; /**< Spacing between output elements */
+  std::size_t output_distance; /**< Spacing between output signals */
+  bool in_place; /**< Output overwrites input */
+};
+
+/**
+ * Transform committed by an FFT backend. Instances are created by
+ * FftBackend::create_plan and wrapped by FftPlan, which validates argument
+ * types before calling compute. Implementations must be safe to compute
+ * concurrently from multiple threads.
+ */
+class FftBackendPlan {
+ public:
+  /**
+   * @constructor Default constructor
+   */
+  FftBackendPlan() = default;
+
+  /**
+   * @destructor Virtual destructor
+   */
+  virtual ~FftBackendPlan() {};
+
+  /**
+   * Delete copy constructor
+   */
+  FftBackendPlan(const FftBackendPlan&) = delete;
+
+  /**
+   * Delete assignment operator
+   */
+  FftBackendPlan& operator=(const FftBackendPlan&) = delete;
+
+  /**
+   * Run transform. Element types of input and output are implied by the
+   * domain, direction and precision the plan was created with.
+   * @param[in] input Pointer to input values
+   * @param[in, out] output Pointer to location to write output to. Null for
+   *                        in-place transforms.
+   */
+  virtual void compute(const void* input, void* output) const = 0;
+};
+
+/**
+ * Abstract base class for libraries that provide Fast Fourier Transforms
+ * (FFT) and direct convolution. The backend used by FftPlan, and therefore by
+ * all transforms and convolutions in numeric_utils, is selected with
+ * set_fft_backend.
+ */
+class FftBackend {
+ public:
+  /**
+   * @constructor Default constructor
+   */
+  FftBackend() = default;
+
+  /**
+   * @destructor Virtual destructor
+   */
+  virtual ~FftBackend() {};
+
+  /**
+   * Delete copy constructor
+   */
+  FftBackend(const FftBackend&) = delete;
+
+  /**
+   * Delete assignment operator
+   */
+  FftBackend& operator=(const FftBackend&) = delete;
+
+  /**
+   * Get the name of the backend
+   * @return Name used to select backend
+   */
+  virtual std::string name() const = 0;
+
+  /**
+   * Create committed transform. Layout has already been validated by caller.
+   * Backward transforms must be scaled by 1/N.
+   * @param[in] length Number of points in each transform
+   * @param[in] direction Direction of transform
+   * @param[in] domain Domain of forward transform input
+   * @param[in] layout Layout of signals in input and output buffers
+   * @param[in] precision Floating point precision of transform
+   * @return Unique pointer to committed transform
+   */
+  virtual std::unique_ptr<FftBackendPlan> create_plan(
+      std::size_t length, FftDirection direction, FftDomain domain,
+      const FftLayout& layout, FftPrecision precision) const = 0;
+
+  /**
+   * Compute the full 1-dimensional convolution of two inputs by direct
+   * summation
+   * @param[in] input_x Pointer to first input
+   * @param[in] size_x Number of values in first input
+   * @param[in] input_y Pointer to second input
+   * @param[in] size_y Number of values in second input
+   * @param[in, out] response Pointer to location to write size_x + size_y - 1
+   *                          output values to
+   */
+  virtual void convolve(const double* input_x, std::size_t size_x,
+                        const double* input_y, std::size_t size_y,
+                        double* response) const = 0;
+
+  /**
+   * Compute the full 1-dimensional convolution of two single precision inputs
+   * by direct summation
+   * @param[in] input_x Pointer to first input
+   * @param[in] size_x Number of values in first input
+   * @param[in] input_y Pointer to second input
+   * @param[in] size_y Number of values in second input
+   * @param[in, out] response Pointer to location to write size_x + size_y - 1
+   *                          output values to
+   */
+  virtual void convolve(const float* input_x, std::size_t size_x,
+                        const float* input_y, std::size_t size_y,
+                        float* response) const = 0;
+};
+
+/**
+ * Get names of FFT backends compiled into the library. The dependency-free
+ * "Native" backend is always available and "MKL" is available when the
+ * library is built with MKL.
+ * @return Names of available backends
+ */
+std::vector<std::string> fft_backends();
+
+/**
+ * Select the FFT backend used for plans created from now on. Plans already
+ * held by callers continue to use the backend they were created with. The
+ * initial backend is taken from the SMELT_FFT_BACKEND environment variable if
+ * set, and otherwise from the default chosen when the library was built.
+ * @param[in] name Name of backend to use
+ */
+void set_fft_backend(const std::string& name);
+
+/**
+ * Get the currently selected FFT backend
+ * @return Shared pointer to selected backend
+ */
+std::shared_ptr<const FftBackend> fft_backend();
+}  // namespace numeric_utils
+
+#endif  // _FFT_BACKEND_H_
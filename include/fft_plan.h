@@ -0,0 +1,309 @@
+#ifndef _FFT_PLAN_H_
+#define _FFT_PLAN_H_
+
+#include <complex>
+#include <cstddef>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include "fft_backend.h"
+
+namespace numeric_utils {
+
+/**
+ * Find the smallest transform length that is at least as large as the input
+ * length and has no prime factors other than 2, 3 and 5. Transforms of such
+ * lengths are substantially faster than those of arbitrary length.
+ * @param[in] min_length Minimum required transform length
+ * @return Fast transform length
+ */
+std::size_t next_fast_fft_length(std::size_t min_length);
+
+/**
+ * Committed 1-dimensional Fast Fourier Transform (FFT) plan. Construction
+ * performs all descriptor setup so that repeated transforms of the same shape
+ * only pay for the computation itself. Backward transforms are scaled by 1/N
+ * so that they are the inverse of the forward transform. A plan may transform
+ * several signals in a single call as described by its FftLayout. Transforms
+ * are computed by the FFT backend selected when the plan is constructed. Plans
+ * are immutable once constructed and may be executed concurrently from
+ * multiple threads.
+ */
+class FftPlan {
+ public:
+  /**
+   * @constructor Construct and commit FFT plan
+   * @param[in] length Number of points in transform
+   * @param[in] direction Direction of transform
+   * @param[in] domain Domain of forward transform input
+   * @param[in] precision Floating point precision of transform. Defaults to
+   *                      double precision.
+   */
+  FftPlan(std::size_t length, FftDirection direction, FftDomain domain,
+          FftPrecision precision = FftPrecision::Double);
+
+  /**
+   * @constructor Construct and commit FFT plan for multiple signals
+   * @param[in] length Number of points in each transform
+   * @param[in] direction Direction of transform
+   * @param[in] domain Domain of forward transform input
+   * @param[in] layout Layout of signals in input and output buffers
+   * @param[in] precision Floating point precision of transform. Defaults to
+   *                      double precision.
+   */
+  FftPlan(std::size_t length, FftDirection direction, FftDomain domain,
+          const FftLayout& layout,
+          FftPrecision precision = FftPrecision::Double);
+
+  /**
+   * @destructor Free backend transform
+   */
+  ~FftPlan();
+
+  /**
+   * Delete copy constructor
+   */
+  FftPlan(const FftPlan&) = delete;
+
+  /**
+   * Delete assignment operator
+   */
+  FftPlan& operator=(const FftPlan&) = delete;
+
+  /**
+   * Execute complex to complex transform. Input and output must each contain
+   * length() values per signal arranged as described by layout().
+   * @param[in] input Pointer to input values
+   * @param[in, out] output Pointer to location to write output to
+   */
+  void execute(const std::complex<double>* input,
+               std::complex<double>* output) const;
+
+  /**
+   * Execute complex to real backward transform. Only the first length() / 2 + 1
+   * values of the input are read, with the remainder implied by conjugate
+   * symmetry. Output must contain length() values.
+   * @param[in] input Pointer to input values
+   * @param[in, out] output Pointer to location to write output to
+   */
+  void execute(const std::complex<double>* input, double* output) const;
+
+  /**
+   * Execute real to complex forward transform. Input must contain length()
+   * values and output length() / 2 + 1 values.
+   * @param[in] input Pointer to input values
+   * @param[in, out] output Pointer to location to write output to
+   */
+  void execute(const double* input, std::complex<double>* output) const;
+
+  /**
+   * Execute single precision complex to complex transform
+   * @param[in] input Pointer to input values
+   * @param[in, out] output Pointer to location to write output to
+   */
+  void execute(const std::complex<float>* input,
+               std::complex<float>* output) const;
+
+  /**
+   * Execute single precision complex to real backward transform
+   * @param[in] input Pointer to input values
+   * @param[in, out] output Pointer to location to write output to
+   */
+  void execute(const std::complex<float>* input, float* output) const;
+
+  /**
+   * Execute single precision real to complex forward transform
+   * @param[in] input Pointer to input values
+   * @param[in, out] output Pointer to location to write output to
+   */
+  void execute(const float* input, std::complex<float>* output) const;
+
+  /**
+   * Execute in-place complex to complex transform, or in-place complex to real
+   * backward transform where the real output overwrites the start of the
+   * buffer. Plan layout must be in-place.
+   * @param[in, out] data Pointer to values to transform
+   */
+  void execute(std::complex<double>* data) const;
+
+  /**
+   * Execute in-place real to complex forward transform, where the half
+   * spectrum overwrites the buffer. Plan layout must be in-place.
+   * @param[in, out] data Pointer to values to transform
+   */
+  void execute(double* data) const;
+
+  /**
+   * Execute single precision in-place complex to complex or complex to real
+   * transform. Plan layout must be in-place.
+   * @param[in, out] data Pointer to values to transform
+   */
+  void execute(std::complex<float>* data) const;
+
+  /**
+   * Execute single precision in-place real to complex forward transform. Plan
+   * layout must be in-place.
+   * @param[in, out] data Pointer to values to transform
+   */
+  void execute(float* data) const;
+
+  /**
+   * Get the transform length
+   * @return Number of points in transform
+   */
+  std::size_t length() const { return length_; }
+
+  /**
+   * Get the name of the backend computing the transform
+   * @return Backend name
+   */
+  const std::string& backend() const { return backend_; }
+
+  /**
+   * Get the layout of signals transformed by plan
+   * @return Layout of input and output buffers
+   */
+  const FftLayout& layout() const { return layout_; }
+
+  /**
+   * Get the transform direction
+   * @return Direction of transform
+   */
+  FftDirection direction() const { return direction_; }
+
+  /**
+   * Get the transform domain
+   * @return Domain of forward transform input
+   */
+  FftDomain domain() const { return domain_; }
+
+  /**
+   * Get the transform precision
+   * @return Floating point precision of transform
+   */
+  FftPrecision precision() const { return precision_; }
+
+ private:
+  /**
+   * Check that requested execution matches plan configuration and run it
+   * @param[in] domain Domain implied by argument types
+   * @param[in] precision Precision implied by argument types
+   * @param[in] input Pointer to input values
+   * @param[in, out] output Pointer to location to write output to. Null for
+   *                        in-place transforms.
+   */
+  void compute(FftDomain domain, FftPrecision precision, const void* input,
+               void* output) const;
+
+  std::size_t length_; /**< Number of points in transform */
+  FftDirection direction_; /**< Direction of transform */
+  FftDomain domain_; /**< Domain of forward transform input */
+  FftPrecision precision_; /**< Floating point precision */
+  FftLayout layout_; /**< Layout of signals in input and output */
+  std::string backend_; /**< Name of backend computing transform */
+  std::unique_ptr<FftBackendPlan>
+      backend_plan_; /**< Transform committed by backend */
+};
+
+/**
+ * Singleton, thread-safe cache of committed FFT plans keyed on backend, length,
+ * direction, domain, precision and layout. The cache holds at most
+ * capacity() plans and evicts the least recently used plan when full. Evicted
+ * plans remain valid for as long as a caller holds on to them.
+ */
+class FftPlanCache {
+ public:
+  /**
+   * Get the single instance of the plan cache
+   */
+  static FftPlanCache* instance() {
+    static FftPlanCache cache;
+    return &cache;
+  }
+
+  /**
+   * Get plan matching input configuration, creating and committing a new one
+   * if it is not already cached. Plans are created with the currently
+   * selected FFT backend.
+   * @param[in] length Number of points in transform
+   * @param[in] direction Direction of transform
+   * @param[in] domain Domain of forward transform input
+   * @param[in] precision Floating point precision of transform. Defaults to
+   *                      double precision.
+   * @return Shared pointer to committed plan
+   */
+  std::shared_ptr<const FftPlan> plan(
+      std::size_t length, FftDirection direction, FftDomain domain,
+      FftPrecision precision = FftPrecision::Double);
+
+  /**
+   * Get plan for multiple signals matching input configuration, creating and
+   * committing a new one if it is not already cached. Plans are created with the currently
+   * selected FFT backend.
+   * @param[in] length Number of points in each transform
+   * @param[in] direction Direction of transform
+   * @param[in] domain Domain of forward transform input
+   * @param[in] layout Layout of signals in input and output buffers
+   * @param[in] precision Floating point precision of transform. Defaults to
+   *                      double precision.
+   * @return Shared pointer to committed plan
+   */
+  std::shared_ptr<const FftPlan> plan(
+      std::size_t length, FftDirection direction, FftDomain domain,
+      const FftLayout& layout, FftPrecision precision = FftPrecision::Double);
+
+  /**
+   * Set the maximum number of plans held by the cache. Least recently used
+   * plans are evicted if the cache currently holds more than this.
+   * @param[in] capacity Maximum number of cached plans
+   */
+  void set_capacity(std::size_t capacity);
+
+  /**
+   * Get the maximum number of plans held by the cache
+   * @return Maximum number of cached plans
+   */
+  std::size_t capacity() const;
+
+  /**
+   * Get the number of plans currently cached
+   * @return Number of cached plans
+   */
+  std::size_t size() const;
+
+  /**
+   * Remove all plans from cache
+   */
+  void clear();
+
+ private:
+  /**
+   * Private constructor
+   */
+  FftPlanCache() = default;
+
+  /**
+   * Evict least recently used plans until cache size is within capacity.
+   * Caller must hold the cache mutex.
+   */
+  void trim();
+
+  typedef std::tuple<std::string, std::size_t, FftDirection, FftDomain,
+                     FftPrecision,
+                     std::tuple<std::size_t, std::size_t, std::size_t,
+                                std::size_t, std::size_t, bool>>
+      PlanKey; /**< Cache key */
+  typedef std::list<std::pair<PlanKey, std::shared_ptr<const FftPlan>>>
+      PlanList; /**< Plans ordered from most to least recently used */
+
+  mutable std::mutex mutex_; /**< Mutex guarding cache state */
+  std::size_t capacity_ = 64; /**< Maximum number of cached plans */
+  PlanList plans_; /**< Cached plans in order of use */
+  std::map<PlanKey, PlanList::iterator> lookup_; /**< Map from key to plan */
+};
+}  // namespace numeric_utils
+
+#endif  // _FFT_PLAN_H_
@@ -0,0 +1,80 @@
+#ifndef _LHS_NORMAL_MULTIVAR_H_
+#define _LHS_NORMAL_MULTIVAR_H_
+
+// Eigen dense matrices
+#include <Eigen/Dense>
+
+#include "normal_multivar.h"
+
+namespace numeric_utils {
+/**
+ * Class for generating random realizations of a multivariate normal
+ * distribution using Latin hypercube sampling. Each random variable is
+ * stratified into as many equally probable intervals as there are cases
+ * generated in a call, with exactly one unit normal value drawn from each
+ * interval, so ensemble statistics converge with fewer realizations than with
+ * plain Monte Carlo sampling. Truncated realizations are drawn from Latin
+ * hypercubes of unit normal values by rejecting realizations out of bounds.
+ */
+class LhsNormalMultiVar : public NormalMultiVar {
+ public:
+  /**
+   * @constructor Default constructor
+   */
+  LhsNormalMultiVar();
+
+  /**
+   * @constructor Construct an instance of the Latin hypercube multivariate
+   * normal random number generator
+   * @param[in] seed Seed value to use in random number generator
+   */
+  LhsNormalMultiVar(int seed);
+
+  /**
+   * @destructor Virtual destructor
+   */
+  virtual ~LhsNormalMultiVar(){};
+
+  /**
+   * Get the class name
+   * @return Class name
+   */
+  std::string name() const override;
+
+  /**
+   * Get Latin hypercube sample of the prepared distribution truncated to a
+   * box. Unit normal values are stratified before the covariance transform,
+   * so every column of a block is an exact realization of the untruncated
+   * distribution. Columns outside the bounds are rejected, which keeps the
+   * joint distribution, including dependence between random variables, for
+   * any number of cases. Each block is sized so that about as many columns as
+   * remaining cases are accepted, so stratification is only thinned by the
+   * rejected columns. Strata are not balanced after rejection, so variance
+   * reduction falls off as the rejected fraction grows. With many truncated
+   * variables, as for the near-fault model parameters where about half of
+   * the columns are rejected, variance of the sample mean is only about
+   * halved compared to independent sampling, well short of the reduction
+   * from untruncated Latin hypercube sampling.
+   * @param[in, out] random_numbers Matrix to store generated random numbers to
+   * @param[in] lower Lower bound for each random variable
+   * @param[in] upper Upper bound for each random variable
+   * @param[in] cases Number of cases to generate
+   */
+  void draw_truncated(
+      Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>& random_numbers,
+      const Eigen::VectorXd& lower, const Eigen::VectorXd& upper,
+      unsigned int cases) override;
+
+ protected:
+  /**
+   * Fill matrix with Latin hypercube sample of unit normal values. Strata of
+   * each random variable are randomly permuted across cases and values are
+   * drawn uniformly within each stratum before mapping to normal space.
+   * @param[in, out] unit_normals Matrix to fill, with one row per random
+   *                              variable and one column per case
+   */
+  void fill_unit_normals(Eigen::MatrixXd& unit_normals) override;
+};
+}  // namespace numeric_utils
+
+#endif  // _LHS_NORMAL_MULTIVAR_H_
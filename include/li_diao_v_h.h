@@ -1,6 +1,7 @@
 #ifndef _LI_DIAO_V_H_H_
 #define _LI_DIAO_V_H_H_
 
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <string>
@@ -69,12 +70,20 @@ class LiningDiaozemin : public StochasticModel {
    *               synthetic motion
    * @param[in] seed_value Value to seed random variables with to ensure
    *               repeatability
+   * @param[in] sample_generator Name of random number generator registered in
+   *                             factory used to sample model parameters.
+   *                             Defaults to "MultivariateNormal", while
+   *                             "MultivariateNormalLHS" uses Latin hypercube
+   *                             sampling. Model parameters are truncated, so
+   *                             Latin hypercube sampling reduces variance
+   *                             much less than for untruncated parameters.
    */
   LiningDiaozemin(FaultType faulting, SimulationType simulation_type,
                        double moment_magnitude, double depth_to_rupt,
                        double rupture_distance, double vs30, double s_or_d,
                        unsigned int num_sims, unsigned int num_realizations, 
-                       bool truncate, int seed_value);
+                       bool truncate, int seed_value,
+                       const std::string& sample_generator = "MultivariateNormal");
 
   /**
    * @destructor Virtual destructor
@@ -139,6 +148,26 @@ class LiningDiaozemin : public StochasticModel {
   Eigen::MatrixXd simulate_model_parameters(bool pulse_like,
                                             unsigned int num_sims);
 
+  /**
+   * Simulate model parameters for ground motions based on either pulse-like
+   * or non-pulse-like behavior along with their likelihood ratio weights.
+   * When importance sampling, the proposal shift has one value for each of
+   * the 19 pulse-like model parameters, where the last 14 also apply to the
+   * non-pulse-like model parameters. Proposal realizations are truncated to
+   * the same bounds as the model distribution, and weights are likelihood
+   * ratios of the truncated distributions, which are not normalized.
+   * @param[in] pulse_like Boolean indicating whether ground motions are
+   *                       pulse-like
+   * @param[in] num_sims Number of simulations to simulate model parameters for
+   * @param[in, out] weights Vector to store likelihood ratio weight of each
+   *                         set of model parameters to, which are all 1.0
+   *                         when model parameters are not importance sampled
+   * @return Model parameters for ground motions
+   */
+  Eigen::MatrixXd simulate_model_parameters(bool pulse_like,
+                                            unsigned int num_sims,
+                                            Eigen::VectorXd& weights);
+
   /**
    * Compute the conditional mean values of the transformed model parameters
    * using regressiong coefficients and Equation 12 from Dabaghi & Der
@@ -149,14 +178,49 @@ class LiningDiaozemin : public StochasticModel {
    */
   Eigen::VectorXd compute_transformed_model_parameters(bool pulse_like) const;
 
+  /**
+   * Check additional constraint on pulse-like model parameters for a block of
+   * candidates, which requires the time of the pulse peak to be at least half
+   * the pulse duration, the product of pulse period and oscillation
+   * parameter, so that the pulse does not start before the record
+   * @param[in] parameters Matrix with model parameters in normal space for
+   *                       one candidate per column
+   * @return Array indicating whether each candidate satisfies the constraint
+   */
+  Eigen::Array<bool, 1, Eigen::Dynamic> check_pulse_parameters(
+      const Eigen::MatrixXd& parameters) const;
+
   /**
    * Transforms model parameters from normal space back to real space
    * @param[in] pulse_like Boolean indicating whether ground motions are
    *                       pulse-like
-   * @param[in, out] parameters Vector of parameters in normal space. Transformed variables will be
-   *                            stored in this vector.
+   * @param[in, out] parameters Vector of parameters in normal space, or matrix
+   *                            with one set of parameters per column.
+   *                            Transformed variables will be stored in place.
    */
-  void transform_parameters_from_normal_space(bool pulse_like, Eigen::VectorXd& parameters);
+  void transform_parameters_from_normal_space(
+      bool pulse_like, Eigen::Ref<Eigen::MatrixXd> parameters);
+
+  /**
+   * Transform values from normal space to beta distribution fitted to model
+   * parameter, scaled to the bounds of the parameter
+   * @param[in, out] values Values in normal space to transform in place
+   * @param[in] index Index of model parameter whose fitted distribution and
+   *                  bounds to use
+   * @param[in] exponentiate Whether to exponentiate scaled values, for
+   *                         parameters fitted in log space
+   */
+  void transform_from_beta(stochastic::ValuesRef values, unsigned int index,
+                           bool exponentiate) const;
+
+  /**
+   * Transform values from normal space to double-exponential distribution
+   * fitted to model parameter
+   * @param[in, out] values Values in normal space to transform in place
+   * @param[in] index Index of model parameter whose fitted distribution to use
+   */
+  void transform_from_double_exp(stochastic::ValuesRef values,
+                                 unsigned int index) const;
 
   /**
    * Calculate the inverse of double-exponential distribution
@@ -182,12 +246,15 @@ class LiningDiaozemin : public StochasticModel {
    *                             in direction 2. Outputs are written here.
    * @param[in] num_gms Number of ground motions that should be generated.
    *                    Defaults to 1.
+   * @param[in] event_index Index of first ground motion within the event
+   *                        ensemble, which selects the random streams used for
+   *                        white noise. Defaults to 0.
    */
   void simulate_near_fault_ground_motion(
       bool pulse_like, const Eigen::VectorXd& parameters,
       std::vector<std::vector<double>>& accel_comp_1,
       std::vector<std::vector<double>>& accel_comp_2,
-      unsigned int num_gms = 1) const;
+      unsigned int num_gms = 1, unsigned int event_index = 0) const;
 
   /**
    * Backcalculate modulating parameters given Arias Intesity and duration parameters
@@ -205,13 +272,20 @@ class LiningDiaozemin : public StochasticModel {
    * @param[in] num_steps Total number of time steps to be taken
    * @param[in] num_gms Number of ground motions that should be generated.
    *                    Defaults to 1.
+   * @param[in] event_index Index of first ground motion within the event
+   *                        ensemble. White noise for each ground motion is
+   *                        drawn from the random stream keyed on its index
+   *                        and the component. Defaults to 0.
+   * @param[in] component Index of ground motion component. Defaults to 0.
    * @return Vector of vectors containing time history of simulated modulate
    *         filtered white noise
    */
   Eigen::MatrixXd simulate_white_noise(const Eigen::VectorXd& modulating_params,
                                        const Eigen::VectorXd& filter_params,
                                        unsigned int num_steps,
-                                       unsigned int num_gms = 1) const;
+                                       unsigned int num_gms = 1,
+                                       unsigned int event_index = 0,
+                                       unsigned int component = 0) const;
 
   /**
    * This function defines an error measure based on matching times of the 5%,
@@ -255,6 +329,18 @@ class LiningDiaozemin : public StochasticModel {
   double calc_time_to_intensity(const std::vector<double>& acceleration,
                                 double percentage) const;
 
+  /**
+   * Calculate the times at which the input percentages of the Arias intensity
+   * are reached, searching for all percentages in a single pass
+   * @param[in] acceleration Acceleration time history
+   * @param[in] percentages Percentages of Arias intensity to be reached
+   * @return Times at which input percentages of Arias intensity are reached,
+   *         in the same order as the percentages
+   */
+  std::vector<double> calc_times_to_intensity(
+      const std::vector<double>& acceleration,
+      const std::vector<double>& percentages) const;
+
   /**
    * Calculate the linearly varying filter function (in rad/sec) given the
    * filter function parameters (in Hz) and the times of 1%, 30%(mid) and 99%
@@ -299,6 +385,20 @@ class LiningDiaozemin : public StochasticModel {
                                           double freq_corner,
                                           unsigned int filter_order) const;
 
+  /**
+   * Filters all rows of input acceleration time histories in frequency domain
+   * using acausal high-pass Butterworth filter. All histories are transformed
+   * together using batched FFTs.
+   * @param[in] accel_histories Matrix where each row is an acceleration time
+   *                            history to filter
+   * @param[in] freq_corner Corner frequency
+   * @param[in] filter_order Order of filter
+   * @return Vector of filtered time histories, one for each row of input
+   */
+  std::vector<std::vector<double>> filter_acceleration(
+      const Eigen::MatrixXd& accel_histories, double freq_corner,
+      unsigned int filter_order) const;
+
   /**
    * Calculate the pulse acceleration based on the modified Mavroeidis and
    * Papageorgiou model
@@ -331,14 +431,16 @@ class LiningDiaozemin : public StochasticModel {
 
   /**
    * Baseline correct acceleration time histories by fitting a polynomial
-   * starting from the 2nd degree of the displacement time series
-   * @param[in, out] time_history Acceleration time history to truncate
+   * starting from the 2nd degree of the displacement time series. Records of
+   * equal length are fitted together in a single call to a cached fitter.
+   * @param[in, out] time_histories Acceleration time histories to correct
    * @param[in] gfactor Factor to convert acceleration to cm/s^2
    * @param[in] order Order of the polynomial fitted to the displacement time
    *                  series
    */
-  void baseline_correct_time_history(std::vector<double>& time_history,
-                                     double gfactor, unsigned int order) const;
+  void baseline_correct_time_histories(
+      std::vector<std::vector<double>>& time_histories, double gfactor,
+      unsigned int order) const;
 
   /**
    * Convert input time history to units of g or m/s^2
@@ -365,6 +467,7 @@ class LiningDiaozemin : public StochasticModel {
                              motion time histories that should be generated */
   unsigned int num_realizations_; /**< Number of realizations of model parameters */
   int seed_value_; /**< Integer to seed random distributions with */
+  std::uint64_t stream_seed_; /**< Seed for random streams of simulations */
   double time_step_; /**< Temporal discretization. Set to 0.005 seconds */
   double start_time_ = 0.0; /**< Start time of ground motion */
   Eigen::VectorXd std_dev_pulse_; /**< Pulse-like parameter standard deviation */
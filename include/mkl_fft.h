@@ -0,0 +1,114 @@
+#ifndef _MKL_FFT_H_
+#define _MKL_FFT_H_
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include "fft_backend.h"
+
+// Forward declaration of MKL descriptor so MKL headers stay out of the
+// public interface
+struct DFTI_DESCRIPTOR;
+
+namespace numeric_utils {
+
+/**
+ * Transform committed using Intel MKL DFTI descriptor
+ */
+class MklFftPlan : public FftBackendPlan {
+ public:
+  /**
+   * @constructor Construct and commit MKL descriptor
+   * @param[in] length Number of points in each transform
+   * @param[in] direction Direction of transform
+   * @param[in] domain Domain of forward transform input
+   * @param[in] layout Layout of signals in input and output buffers
+   * @param[in] precision Floating point precision of transform
+   */
+  MklFftPlan(std::size_t length, FftDirection direction, FftDomain domain,
+             const FftLayout& layout, FftPrecision precision);
+
+  /**
+   * @destructor Free MKL descriptor
+   */
+  virtual ~MklFftPlan();
+
+  /**
+   * Run transform
+   * @param[in] input Pointer to input values
+   * @param[in, out] output Pointer to location to write output to. Null for
+   *                        in-place transforms.
+   */
+  void compute(const void* input, void* output) const override;
+
+ private:
+  FftDirection direction_; /**< Direction of transform */
+  DFTI_DESCRIPTOR* descriptor_; /**< Committed MKL descriptor */
+};
+
+/**
+ * FFT backend using Intel MKL DFTI for transforms and MKL VSL for direct
+ * convolution
+ */
+class MklFftBackend : public FftBackend {
+ public:
+  /**
+   * @constructor Default constructor
+   */
+  MklFftBackend() = default;
+
+  /**
+   * @destructor Virtual destructor
+   */
+  virtual ~MklFftBackend() {};
+
+  /**
+   * Get the name of the backend
+   * @return Backend name
+   */
+  std::string name() const override { return "MKL"; }
+
+  /**
+   * Create committed transform
+   * @param[in] length Number of points in each transform
+   * @param[in] direction Direction of transform
+   * @param[in] domain Domain of forward transform input
+   * @param[in] layout Layout of signals in input and output buffers
+   * @param[in] precision Floating point precision of transform
+   * @return Unique pointer to committed transform
+   */
+  std::unique_ptr<FftBackendPlan> create_plan(
+      std::size_t length, FftDirection direction, FftDomain domain,
+      const FftLayout& layout, FftPrecision precision) const override;
+
+  /**
+   * Compute the full 1-dimensional convolution of two inputs by direct
+   * summation
+   * @param[in] input_x Pointer to first input
+   * @param[in] size_x Number of values in first input
+   * @param[in] input_y Pointer to second input
+   * @param[in] size_y Number of values in second input
+   * @param[in, out] response Pointer to location to write size_x + size_y - 1
+   *                          output values to
+   */
+  void convolve(const double* input_x, std::size_t size_x,
+                const double* input_y, std::size_t size_y,
+                double* response) const override;
+
+  /**
+   * Compute the full 1-dimensional convolution of two single precision inputs
+   * by direct summation
+   * @param[in] input_x Pointer to first input
+   * @param[in] size_x Number of values in first input
+   * @param[in] input_y Pointer to second input
+   * @param[in] size_y Number of values in second input
+   * @param[in, out] response Pointer to location to write size_x + size_y - 1
+   *                          output values to
+   */
+  void convolve(const float* input_x, std::size_t size_x,
+                const float* input_y, std::size_t size_y,
+                float* response) const override;
+};
+}  // namespace numeric_utils
+
+#endif  // _MKL_FFT_H_
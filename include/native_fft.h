@@ -0,0 +1,200 @@
+#ifndef _NATIVE_FFT_H_
+#define _NATIVE_FFT_H_
+
+#include <complex>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+#include "fft_backend.h"
+
+namespace numeric_utils {
+
+/**
+ * Unnormalized complex Fast Fourier Transform (FFT) of a fixed length
+ * implemented without external dependencies. Lengths whose prime factors are
+ * all small are computed with a mixed-radix Stockham autosort algorithm using
+ * specialized radix 2, 3 and 4 butterflies. Lengths with a large prime factor
+ * are computed with Bluestein's algorithm, which reformulates the transform as
+ * a convolution evaluated with power of two transforms.
+ * @tparam T Floating point type
+ */
+template <typename T>
+class NativeComplexFft {
+ public:
+  /**
+   * @constructor Precompute factorization and twiddle factors
+   * @param[in] length Number of points in transform
+   * @param[in] direction Direction of transform, which sets the sign of the
+   *                      exponent. Backward transforms are not scaled.
+   */
+  NativeComplexFft(std::size_t length, FftDirection direction);
+
+  /**
+   * Transform values in place
+   * @param[in, out] data Pointer to length() values to transform
+   * @param[in] work Pointer to scratch space of at least work_size() values
+   */
+  void transform(std::complex<T>* data, std::complex<T>* work) const;
+
+  /**
+   * Get the transform length
+   * @return Number of points in transform
+   */
+  std::size_t length() const { return length_; }
+
+  /**
+   * Get the amount of scratch space required by transform
+   * @return Number of complex values required for scratch space
+   */
+  std::size_t work_size() const;
+
+ private:
+  /**
+   * Single radix pass of the Stockham algorithm
+   */
+  struct Stage {
+    std::size_t radix; /**< Radix of butterflies */
+    std::size_t sub_length; /**< Length of sub-transforms at this stage */
+    std::size_t stride; /**< Stride between sub-transform elements */
+    std::size_t twiddle_offset; /**< Offset of stage twiddle factors */
+    std::size_t roots_offset; /**< Offset of roots of unity of radix */
+  };
+
+  /**
+   * Run a single Stockham pass from input to output
+   * @param[in] stage Stage to run
+   * @param[in] input Values at start of stage
+   * @param[in, out] output Location to write values at end of stage to
+   */
+  void run_stage(const Stage& stage, const std::complex<T>* input,
+                 std::complex<T>* output) const;
+
+  /**
+   * Transform values using Bluestein's algorithm
+   * @param[in, out] data Pointer to length() values to transform
+   * @param[in] work Pointer to scratch space of at least work_size() values
+   */
+  void bluestein(std::complex<T>* data, std::complex<T>* work) const;
+
+  std::size_t length_; /**< Number of points in transform */
+  T sign_; /**< Sign of exponent, negative for forward transforms */
+  std::vector<Stage> stages_; /**< Stockham passes */
+  std::vector<std::complex<T>>
+      twiddles_; /**< Twiddle factors and roots of unity of all passes */
+  std::unique_ptr<NativeComplexFft<T>>
+      convolution_fft_; /**< Forward transform for Bluestein convolution */
+  std::vector<std::complex<T>> chirp_; /**< Bluestein chirp */
+  std::vector<std::complex<T>>
+      chirp_spectrum_; /**< Scaled transform of Bluestein convolution kernel */
+};
+
+/**
+ * Transform committed by the native backend. Batched and strided layouts are
+ * handled by gathering each signal into contiguous scratch space. Real domain
+ * transforms of even length are computed with a complex transform of half the
+ * length.
+ * @tparam T Floating point type
+ */
+template <typename T>
+class NativeFftPlan : public FftBackendPlan {
+ public:
+  /**
+   * @constructor Precompute transforms
+   * @param[in] length Number of points in each transform
+   * @param[in] direction Direction of transform
+   * @param[in] domain Domain of forward transform input
+   * @param[in] layout Layout of signals in input and output buffers
+   */
+  NativeFftPlan(std::size_t length, FftDirection direction, FftDomain domain,
+                const FftLayout& layout);
+
+  /**
+   * @destructor Virtual destructor
+   */
+  virtual ~NativeFftPlan() {};
+
+  /**
+   * Run transform
+   * @param[in] input Pointer to input values
+   * @param[in, out] output Pointer to location to write output to. Null for
+   *                        in-place transforms.
+   */
+  void compute(const void* input, void* output) const override;
+
+ private:
+  std::size_t length_; /**< Number of points in transform */
+  FftDirection direction_; /**< Direction of transform */
+  FftDomain domain_; /**< Domain of forward transform input */
+  FftLayout layout_; /**< Layout of signals in input and output */
+  T scale_; /**< Scale factor applied to output */
+  NativeComplexFft<T> fft_; /**< Complex transform */
+  std::vector<std::complex<T>>
+      real_twiddles_; /**< Twiddles splitting packed real transforms */
+};
+
+/**
+ * Dependency-free FFT backend that is always available
+ */
+class NativeFftBackend : public FftBackend {
+ public:
+  /**
+   * @constructor Default constructor
+   */
+  NativeFftBackend() = default;
+
+  /**
+   * @destructor Virtual destructor
+   */
+  virtual ~NativeFftBackend() {};
+
+  /**
+   * Get the name of the backend
+   * @return Backend name
+   */
+  std::string name() const override { return "Native"; }
+
+  /**
+   * Create committed transform
+   * @param[in] length Number of points in each transform
+   * @param[in] direction Direction of transform
+   * @param[in] domain Domain of forward transform input
+   * @param[in] layout Layout of signals in input and output buffers
+   * @param[in] precision Floating point precision of transform
+   * @return Unique pointer to committed transform
+   */
+  std::unique_ptr<FftBackendPlan> create_plan(
+      std::size_t length, FftDirection direction, FftDomain domain,
+      const FftLayout& layout, FftPrecision precision) const override;
+
+  /**
+   * Compute the full 1-dimensional convolution of two inputs by direct
+   * summation
+   * @param[in] input_x Pointer to first input
+   * @param[in] size_x Number of values in first input
+   * @param[in] input_y Pointer to second input
+   * @param[in] size_y Number of values in second input
+   * @param[in, out] response Pointer to location to write size_x + size_y - 1
+   *                          output values to
+   */
+  void convolve(const double* input_x, std::size_t size_x,
+                const double* input_y, std::size_t size_y,
+                double* response) const override;
+
+  /**
+   * Compute the full 1-dimensional convolution of two single precision inputs
+   * by direct summation
+   * @param[in] input_x Pointer to first input
+   * @param[in] size_x Number of values in first input
+   * @param[in] input_y Pointer to second input
+   * @param[in] size_y Number of values in second input
+   * @param[in, out] response Pointer to location to write size_x + size_y - 1
+   *                          output values to
+   */
+  void convolve(const float* input_x, std::size_t size_x,
+                const float* input_y, std::size_t size_y,
+                float* response) const override;
+};
+}  // namespace numeric_utils
+
+#endif  // _NATIVE_FFT_H_
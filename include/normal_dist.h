@@ -56,6 +56,13 @@ class NormalDistribution : public Distribution {
   std::vector<double> inv_cumulative_dist_func(
       const std::vector<double>& probabilities) const override;
 
+  /**
+   * Transform values from standard normal space to the distribution in place
+   * @param[in, out] values Values in standard normal space, which are
+   *                        overwritten with the transformed values
+   */
+  void transform_from_std_normal(ValuesRef values) const override;
+
  protected:
   double mean_;                      /**< Distribution mean */
   double std_dev_;                   /**< Distribution standard deviation */
@@ -1,13 +1,11 @@
 #ifndef _NORMAL_MULTIVAR_H_
 #define _NORMAL_MULTIVAR_H_
 
-// Boost random generator
-#include <boost/random/mersenne_twister.hpp>
-#include <boost/random/normal_distribution.hpp>
 // Eigen dense matrices
 #include <Eigen/Dense>
 
 #include "numeric_utils.h"
+#include "random_stream.h"
 
 namespace numeric_utils {
 /**
@@ -47,19 +45,99 @@ class NormalMultiVar : public RandomGenerator {
       const Eigen::VectorXd& means, const Eigen::MatrixXd& cov,
       unsigned int cases = 1) override;
 
+  /**
+   * Get single precision multivariate random realization. The covariance
+   * matrix is decomposed in double precision and unit normal values are drawn
+   * from the same stream as the double precision overload, so only the
+   * transformation to the target distribution is computed in single
+   * precision.
+   * @param[in, out] random_numbers Matrix to store generated random numbers to
+   * @param[in] means Vector of mean values for random variables
+   * @param[in] cov Covariance matrix of for random variables
+   * @param[in] cases Number of cases to generate
+   * @return Returns true if no issues were encountered in Cholesky
+   *         decomposition of covariance matrix, returns false otherwise
+   */
+  bool generate(
+      Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic>& random_numbers,
+      const Eigen::VectorXf& means, const Eigen::MatrixXf& cov,
+      unsigned int cases = 1) override;
+
+  /**
+   * Prepare generator to draw realizations of a fixed distribution by
+   * decomposing the covariance matrix once. Covariance matrices that are only
+   * positive semi-definite, such as nearly singular ones, are decomposed
+   * using LDLT or eigenvalue decomposition when Cholesky decomposition fails.
+   * @param[in] means Vector of mean values for random variables
+   * @param[in] cov Covariance matrix of for random variables
+   * @return Returns true if covariance matrix is positive semi-definite,
+   *         returns false otherwise
+   */
+  bool prepare(const Eigen::VectorXd& means,
+               const Eigen::MatrixXd& cov) override;
+
+  /**
+   * Get multivariate random realizations of the prepared distribution using
+   * the cached decomposition of the covariance matrix
+   * @param[in, out] random_numbers Matrix to store generated random numbers to
+   * @param[in] cases Number of cases to generate
+   */
+  void draw(
+      Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>& random_numbers,
+      unsigned int cases = 1) override;
+
   /**
    * Get the class name
    * @return Class name
    */  
   std::string name() const override;
 
+ protected:
+  /**
+   * Fill matrix with unit normal values used to generate realizations
+   * @param[in, out] unit_normals Matrix to fill, with one row per random
+   *                              variable and one column per case
+   */
+  virtual void fill_unit_normals(Eigen::MatrixXd& unit_normals);
+
+  RandomStream stream_; /**< Counter-based random stream that unit normal
+                           values are drawn from */
+
  private:
-  boost::random::mt19937 generator_; /**< Mersenne Twister random number
-                                        generator */
-  boost::random::normal_distribution<double> distribution_; /**< Normal
-                                                         distribution to use
-                                                         with random number
-                                                         generator */
+  /**
+   * Compute factor of covariance matrix such that the factor multiplied by
+   * its transpose gives the covariance matrix. Uses Cholesky decomposition
+   * when covariance matrix is positive definite and falls back to LDLT or
+   * eigenvalue decomposition for positive semi-definite matrices.
+   * @param[in] cov Covariance matrix of random variables
+   * @param[out] factor Factor of covariance matrix
+   * @param[out] lower_triangular Set to true if factor is lower triangular
+   * @return Returns true if decomposition was successful, false otherwise
+   */
+  bool decompose(const Eigen::MatrixXd& cov, Eigen::MatrixXd& factor,
+                 bool& lower_triangular) const;
+
+  /**
+   * Generate realizations from factor of covariance matrix in requested
+   * precision. Unit normal values for all cases are drawn as a single block
+   * and transformed with one matrix product.
+   * @tparam T Floating point type of realizations
+   * @param[in, out] random_numbers Matrix to store generated random numbers to
+   * @param[in] means Vector of mean values for random variables
+   * @param[in] factor Factor of covariance matrix
+   * @param[in] lower_triangular Whether factor is lower triangular
+   * @param[in] cases Number of cases to generate
+   */
+  template <typename T>
+  void transform_normals(
+      Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& random_numbers,
+      const Eigen::Matrix<T, Eigen::Dynamic, 1>& means,
+      const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& factor,
+      bool lower_triangular, unsigned int cases);
+
+  Eigen::MatrixXd prepared_factor_; /**< Factor of prepared covariance matrix */
+  bool prepared_lower_triangular_ =
+      true; /**< Whether prepared factor is lower triangular */
 };
 }  // namespace numeric_utils
 
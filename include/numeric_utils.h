@@ -2,10 +2,14 @@
 #define _NUMERIC_UTILS_H_
 
 #include <complex>
+#include <cstddef>
 #include <ctime>
+#include <functional>
 #include <utility>
 #include <vector>
 #include <Eigen/Dense>
+#include "fft_plan.h"
+#include "random_stream.h"
 
 /**
  * Numeric utility functions not tied to any particular class
@@ -21,16 +25,90 @@ namespace numeric_utils {
 Eigen::MatrixXd corr_to_cov(const Eigen::MatrixXd& corr,
 			    const Eigen::VectorXd& std_dev);
 
+/**
+ * Method used to compute convolutions
+ */
+enum class ConvolutionMode {
+  Auto,   /**< Choose direct or FFT method based on input lengths */
+  Direct, /**< Direct summation */
+  Fft     /**< Product of Fourier transforms */
+};
+
 /**
  * Compute the 1-dimensional convolution of two input vectors
  * @param[in] input_x First input vector of data
  * @param[in] input_y Second input vector of data
  * @param[out] output Vector to story convolution results to
+ * @param[in] mode Method to use for convolution. Defaults to automatically
+ *                 choosing between direct and FFT convolution based on the
+ *                 lengths of the inputs.
  * @return Returns true if convolution was successful, false otherwise
  */
 bool convolve_1d(const std::vector<double>& input_x,
                  const std::vector<double>& input_y,
-                 std::vector<double>& response);
+                 std::vector<double>& response,
+                 ConvolutionMode mode = ConvolutionMode::Auto);
+
+/**
+ * Compute the 1-dimensional convolution of two single precision input vectors
+ * @param[in] input_x First input vector of data
+ * @param[in] input_y Second input vector of data
+ * @param[out] output Vector to story convolution results to
+ * @param[in] mode Method to use for convolution. Defaults to automatically
+ *                 choosing between direct and FFT convolution based on the
+ *                 lengths of the inputs.
+ * @return Returns true if convolution was successful, false otherwise
+ */
+bool convolve_1d(const std::vector<float>& input_x,
+                 const std::vector<float>& input_y,
+                 std::vector<float>& response,
+                 ConvolutionMode mode = ConvolutionMode::Auto);
+
+/**
+ * Compute the 1-dimensional convolution of two input vectors using the
+ * overlap-add method. The longer input is split into blocks that are each
+ * convolved with the shorter input using fixed-length FFTs, which bounds the
+ * transform size for long records.
+ * @param[in] input_x First input vector of data
+ * @param[in] input_y Second input vector of data
+ * @param[out] output Vector to story convolution results to
+ * @param[in] block_size Number of samples of longer input to process per
+ *                       block. Defaults to 0, in which case the block size is
+ *                       chosen based on the length of the shorter input.
+ * @return Returns true if convolution was successful, false otherwise
+ */
+bool convolve_1d_overlap_add(const std::vector<double>& input_x,
+                             const std::vector<double>& input_y,
+                             std::vector<double>& response,
+                             std::size_t block_size = 0);
+
+/**
+ * Compute the 1-dimensional convolution of two single precision input vectors
+ * using the overlap-add method
+ * @param[in] input_x First input vector of data
+ * @param[in] input_y Second input vector of data
+ * @param[out] output Vector to story convolution results to
+ * @param[in] block_size Number of samples of longer input to process per
+ *                       block. Defaults to 0, in which case the block size is
+ *                       chosen based on the length of the shorter input.
+ * @return Returns true if convolution was successful, false otherwise
+ */
+bool convolve_1d_overlap_add(const std::vector<float>& input_x,
+                             const std::vector<float>& input_y,
+                             std::vector<float>& response,
+                             std::size_t block_size = 0);
+
+/**
+ * Computes the real portion of the 1-dimensional inverse Fast Fourier Transform
+ * (FFT) of the input values, reading the input in place and writing directly
+ * to caller-owned output storage
+ * @param[in] input Pointer to length input values
+ * @param[in, out] output Pointer to location to write length output values to
+ * @param[in] length Number of points in transform
+ * @return Returns true if computations were successful, false otherwise
+ */
+bool inverse_fft(const std::complex<double>* input, double* output,
+                 std::size_t length);
 
 /**
  * Computes the real portion of the 1-dimensional inverse Fast Fourier Transform
@@ -39,7 +117,7 @@ bool convolve_1d(const std::vector<double>& input_x,
  * @param[in, out] output_vector Vector to write output to
  * @return Returns true if computations were successful, false otherwise
  */
-bool inverse_fft(std::vector<std::complex<double>> input_vector,
+bool inverse_fft(const std::vector<std::complex<double>>& input_vector,
                  std::vector<double>& output_vector);
 
 /**
@@ -49,7 +127,7 @@ bool inverse_fft(std::vector<std::complex<double>> input_vector,
  * @param[in, out] output_vector Vector to write output to
  * @return Returns true if computations were successful, false otherwise
  */ 
-bool inverse_fft(const Eigen::VectorXcd& input_vector,
+bool inverse_fft(const Eigen::Ref<const Eigen::VectorXcd>& input_vector,
                  Eigen::VectorXd& output_vector);
 
 /**
@@ -59,9 +137,21 @@ bool inverse_fft(const Eigen::VectorXcd& input_vector,
  * @param[in, out] output_vector Vector to write output to
  * @return Returns true if computations were successful, false otherwise
  */ 
-bool inverse_fft(const Eigen::VectorXcd& input_vector,
+bool inverse_fft(const Eigen::Ref<const Eigen::VectorXcd>& input_vector,
                  std::vector<double>& output_vector);
 
+/**
+ * Computes the 1-dimensional Fast Fourier Transform (FFT) of the input
+ * values, reading the input in place and writing the full spectrum directly to
+ * caller-owned output storage
+ * @param[in] input Pointer to length input values
+ * @param[in, out] output Pointer to location to write length output values to
+ * @param[in] length Number of points in transform
+ * @return Returns true if computations were successful, false otherwise
+ */
+bool fft(const double* input, std::complex<double>* output,
+         std::size_t length);
+
 /**
  * Computes the real portion of the 1-dimensional Fast Fourier Transform
  * (FFT) of the input vector
@@ -69,7 +159,7 @@ bool inverse_fft(const Eigen::VectorXcd& input_vector,
  * @param[in, out] output_vector Vector to write output to
  * @return Returns true if computations were successful, false otherwise
  */
-bool fft(std::vector<double> input_vector,
+bool fft(const std::vector<double>& input_vector,
          std::vector<std::complex<double>>& output_vector);
 
 /**
@@ -79,7 +169,8 @@ bool fft(std::vector<double> input_vector,
  * @param[in, out] output_vector Vector to write output to
  * @return Returns true if computations were successful, false otherwise
  */
-bool fft(const Eigen::VectorXd& input_vector, Eigen::VectorXcd& output_vector);
+bool fft(const Eigen::Ref<const Eigen::VectorXd>& input_vector,
+         Eigen::VectorXcd& output_vector);
 
 /**
  * Computes the real portion of the 1-dimensional Fast Fourier Transform
@@ -88,9 +179,251 @@ bool fft(const Eigen::VectorXd& input_vector, Eigen::VectorXcd& output_vector);
  * @param[in, out] output_vector Vector to write output to
  * @return Returns true if computations were successful, false otherwise
  */
-bool fft(const Eigen::VectorXd& input_vector,
+bool fft(const Eigen::Ref<const Eigen::VectorXd>& input_vector,
          std::vector<std::complex<double>>& output_vector);
 
+/**
+ * Computes the 1-dimensional real-to-complex Fast Fourier Transform (FFT) of
+ * the input values, reading the input in place and writing the half spectrum
+ * directly to caller-owned output storage
+ * @param[in] input Pointer to length input values
+ * @param[in, out] output Pointer to location to write length / 2 + 1 output
+ *                        values to
+ * @param[in] length Number of points in transform
+ * @return Returns true if computations were successful, false otherwise
+ */
+bool fft_r2c(const double* input, std::complex<double>* output,
+             std::size_t length);
+
+/**
+ * Computes the 1-dimensional single precision real-to-complex Fast Fourier
+ * Transform (FFT) of the input values
+ * @param[in] input Pointer to length input values
+ * @param[in, out] output Pointer to location to write length / 2 + 1 output
+ *                        values to
+ * @param[in] length Number of points in transform
+ * @return Returns true if computations were successful, false otherwise
+ */
+bool fft_r2c(const float* input, std::complex<float>* output,
+             std::size_t length);
+
+/**
+ * Computes the 1-dimensional real-to-complex Fast Fourier Transform (FFT) of
+ * the input vector. Only the non-redundant half of the conjugate-symmetric
+ * spectrum is returned, so for an input of length N the output contains
+ * N / 2 + 1 values.
+ * @param[in] input_vector Input vector to compute the FFT of
+ * @param[in, out] output_vector Vector to write half spectrum to
+ * @return Returns true if computations were successful, false otherwise
+ */
+bool fft_r2c(const std::vector<double>& input_vector,
+             std::vector<std::complex<double>>& output_vector);
+
+/**
+ * Computes the 1-dimensional real-to-complex Fast Fourier Transform (FFT) of
+ * the input vector. Only the non-redundant half of the conjugate-symmetric
+ * spectrum is returned, so for an input of length N the output contains
+ * N / 2 + 1 values.
+ * @param[in] input_vector Input vector to compute the FFT of
+ * @param[in, out] output_vector Vector to write half spectrum to
+ * @return Returns true if computations were successful, false otherwise
+ */
+bool fft_r2c(const Eigen::Ref<const Eigen::VectorXd>& input_vector,
+             Eigen::VectorXcd& output_vector);
+
+/**
+ * Computes the 1-dimensional real-to-complex Fast Fourier Transform (FFT) of
+ * the input vector. Only the non-redundant half of the conjugate-symmetric
+ * spectrum is returned, so for an input of length N the output contains
+ * N / 2 + 1 values.
+ * @param[in] input_vector Input vector to compute the FFT of
+ * @param[in, out] output_vector Vector to write half spectrum to
+ * @return Returns true if computations were successful, false otherwise
+ */
+bool fft_r2c(const Eigen::Ref<const Eigen::VectorXd>& input_vector,
+             std::vector<std::complex<double>>& output_vector);
+
+/**
+ * Computes the 1-dimensional real-to-complex Fast Fourier Transform (FFT) in
+ * place. The buffer must hold 2 * (length / 2 + 1) values, of which the first
+ * length are the input signal. On return the buffer holds the length / 2 + 1
+ * complex values of the half spectrum as interleaved real and imaginary parts.
+ * @param[in, out] data Pointer to padded input signal, overwritten with half
+ *                      spectrum
+ * @param[in] length Number of points in transform
+ * @return Returns true if computations were successful, false otherwise
+ */
+bool fft_r2c_inplace(double* data, std::size_t length);
+
+/**
+ * Computes the 1-dimensional complex-to-real inverse Fast Fourier Transform
+ * (FFT) of the input half spectrum, reading the input in place and writing
+ * directly to caller-owned output storage
+ * @param[in] input Pointer to length / 2 + 1 half spectrum values
+ * @param[in, out] output Pointer to location to write length output values to
+ * @param[in] length Number of points in output time history
+ * @return Returns true if computations were successful, false otherwise
+ */
+bool inverse_fft_c2r(const std::complex<double>* input, double* output,
+                     std::size_t length);
+
+/**
+ * Computes the 1-dimensional single precision complex-to-real inverse Fast
+ * Fourier Transform (FFT) of the input half spectrum
+ * @param[in] input Pointer to length / 2 + 1 half spectrum values
+ * @param[in, out] output Pointer to location to write length output values to
+ * @param[in] length Number of points in output time history
+ * @return Returns true if computations were successful, false otherwise
+ */
+bool inverse_fft_c2r(const std::complex<float>* input, float* output,
+                     std::size_t length);
+
+/**
+ * Computes the 1-dimensional complex-to-real inverse Fast Fourier Transform
+ * (FFT) of the input half spectrum. The remaining half of the spectrum is
+ * implied by conjugate symmetry and the imaginary parts of the zero and
+ * Nyquist frequency terms are ignored.
+ * @param[in] input_vector Half spectrum containing at least length / 2 + 1
+ *                         values
+ * @param[in, out] output_vector Vector to write output to
+ * @param[in] length Number of points in output time history
+ * @return Returns true if computations were successful, false otherwise
+ */
+bool inverse_fft_c2r(const std::vector<std::complex<double>>& input_vector,
+                     std::vector<double>& output_vector, std::size_t length);
+
+/**
+ * Computes the 1-dimensional complex-to-real inverse Fast Fourier Transform
+ * (FFT) of the input half spectrum. The remaining half of the spectrum is
+ * implied by conjugate symmetry and the imaginary parts of the zero and
+ * Nyquist frequency terms are ignored.
+ * @param[in] input_vector Half spectrum containing at least length / 2 + 1
+ *                         values
+ * @param[in, out] output_vector Vector to write output to
+ * @param[in] length Number of points in output time history
+ * @return Returns true if computations were successful, false otherwise
+ */
+bool inverse_fft_c2r(const Eigen::Ref<const Eigen::VectorXcd>& input_vector,
+                     std::vector<double>& output_vector, std::size_t length);
+
+/**
+ * Computes the 1-dimensional complex-to-real inverse Fast Fourier Transform
+ * (FFT) in place. The buffer holds the length / 2 + 1 values of the half
+ * spectrum on input and the first length real values, read as doubles, hold
+ * the time history on return.
+ * @param[in, out] data Pointer to half spectrum, overwritten with time history
+ * @param[in] length Number of points in output time history
+ * @return Returns true if computations were successful, false otherwise
+ */
+bool inverse_fft_c2r_inplace(std::complex<double>* data, std::size_t length);
+
+/**
+ * Computes the real-to-complex Fast Fourier Transform (FFT) of each column of
+ * the input matrix in a single batched transform
+ * @param[in] input_matrix Matrix where each column is a signal to transform
+ * @param[in, out] output_matrix Matrix to write half spectra to, with
+ *                               rows() / 2 + 1 rows and one column per signal
+ * @return Returns true if computations were successful, false otherwise
+ */
+bool fft_r2c_batch(const Eigen::MatrixXd& input_matrix,
+                   Eigen::MatrixXcd& output_matrix);
+
+/**
+ * Computes the single precision real-to-complex Fast Fourier Transform (FFT)
+ * of each column of the input matrix in a single batched transform
+ * @param[in] input_matrix Matrix where each column is a signal to transform
+ * @param[in, out] output_matrix Matrix to write half spectra to, with
+ *                               rows() / 2 + 1 rows and one column per signal
+ * @return Returns true if computations were successful, false otherwise
+ */
+bool fft_r2c_batch(const Eigen::MatrixXf& input_matrix,
+                   Eigen::MatrixXcf& output_matrix);
+
+/**
+ * Computes the real-to-complex Fast Fourier Transform (FFT) of multiple
+ * signals stored in a strided buffer in a single batched transform
+ * @param[in] input Pointer to first element of first input signal
+ * @param[in, out] output Pointer to location to write first element of first
+ *                        half spectrum to
+ * @param[in] length Number of points in each input signal
+ * @param[in] layout Number of signals and their strides and distances in the
+ *                   input and output buffers
+ * @return Returns true if computations were successful, false otherwise
+ */
+bool fft_r2c_batch(const double* input, std::complex<double>* output,
+                   std::size_t length, const FftLayout& layout);
+
+/**
+ * Computes the single precision real-to-complex Fast Fourier Transform (FFT)
+ * of multiple signals stored in a strided buffer in a single batched transform
+ * @param[in] input Pointer to first element of first input signal
+ * @param[in, out] output Pointer to location to write first element of first
+ *                        half spectrum to
+ * @param[in] length Number of points in each input signal
+ * @param[in] layout Number of signals and their strides and distances in the
+ *                   input and output buffers
+ * @return Returns true if computations were successful, false otherwise
+ */
+bool fft_r2c_batch(const float* input, std::complex<float>* output,
+                   std::size_t length, const FftLayout& layout);
+
+/**
+ * Computes the complex-to-real inverse Fast Fourier Transform (FFT) of each
+ * column of the input matrix of half spectra in a single batched transform
+ * @param[in] input_matrix Matrix where each column is a half spectrum with at
+ *                         least length / 2 + 1 rows
+ * @param[in, out] output_matrix Matrix to write signals to, with length rows
+ *                               and one column per signal
+ * @param[in] length Number of points in each output signal
+ * @return Returns true if computations were successful, false otherwise
+ */
+bool inverse_fft_c2r_batch(const Eigen::MatrixXcd& input_matrix,
+                           Eigen::MatrixXd& output_matrix, std::size_t length);
+
+/**
+ * Computes the single precision complex-to-real inverse Fast Fourier Transform
+ * (FFT) of each column of the input matrix of half spectra in a single batched
+ * transform
+ * @param[in] input_matrix Matrix where each column is a half spectrum with at
+ *                         least length / 2 + 1 rows
+ * @param[in, out] output_matrix Matrix to write signals to, with length rows
+ *                               and one column per signal
+ * @param[in] length Number of points in each output signal
+ * @return Returns true if computations were successful, false otherwise
+ */
+bool inverse_fft_c2r_batch(const Eigen::MatrixXcf& input_matrix,
+                           Eigen::MatrixXf& output_matrix, std::size_t length);
+
+/**
+ * Computes the complex-to-real inverse Fast Fourier Transform (FFT) of
+ * multiple half spectra stored in a strided buffer in a single batched
+ * transform
+ * @param[in] input Pointer to first element of first half spectrum
+ * @param[in, out] output Pointer to location to write first element of first
+ *                        output signal to
+ * @param[in] length Number of points in each output signal
+ * @param[in] layout Number of signals and their strides and distances in the
+ *                   input and output buffers
+ * @return Returns true if computations were successful, false otherwise
+ */
+bool inverse_fft_c2r_batch(const std::complex<double>* input, double* output,
+                           std::size_t length, const FftLayout& layout);
+
+/**
+ * Computes the single precision complex-to-real inverse Fast Fourier Transform
+ * (FFT) of multiple half spectra stored in a strided buffer in a single
+ * batched transform
+ * @param[in] input Pointer to first element of first half spectrum
+ * @param[in, out] output Pointer to location to write first element of first
+ *                        output signal to
+ * @param[in] length Number of points in each output signal
+ * @param[in] layout Number of signals and their strides and distances in the
+ *                   input and output buffers
+ * @return Returns true if computations were successful, false otherwise
+ */
+bool inverse_fft_c2r_batch(const std::complex<float>* input, float* output,
+                           std::size_t length, const FftLayout& layout);
+
 /**
  * Calculate the integral of the input vector with uniform spacing
  * between data points
@@ -109,6 +442,149 @@ double trapazoid_rule(const std::vector<double>& input_vector, double spacing);
  */
 double trapazoid_rule(const Eigen::VectorXd& input_vector, double spacing);
 
+/**
+ * Calculate the cumulative integral of records with uniform spacing between
+ * data points using the trapezoidal rule. The first value of each integral is
+ * zero. Records are processed in blocks so that the running sums of several
+ * records are updated together at each step.
+ * @param[in] input Pointer to num_records records of length values each,
+ *                  stored contiguously one after another
+ * @param[out] output Pointer to location to write integrals to, with the same
+ *                    layout as the input. May be the same as input for
+ *                    in-place integration.
+ * @param[in] length Number of values in each record
+ * @param[in] num_records Number of records
+ * @param[in] spacing Spacing between data points
+ */
+void cumulative_trapezoid(const double* input, double* output,
+                          std::size_t length, std::size_t num_records,
+                          double spacing);
+
+/**
+ * Calculate the cumulative integral of records in place using the
+ * trapezoidal rule
+ * @param[in, out] records Matrix with one record per column, overwritten with
+ *                         the cumulative integrals
+ * @param[in] spacing Spacing between data points
+ */
+void cumulative_trapezoid(Eigen::MatrixXd& records, double spacing);
+
+/**
+ * Integrate records twice using running sums, which is how acceleration time
+ * histories are integrated to velocity and displacement. For input a, the
+ * first integral is v_i = spacing * sum_{k <= i} scale * a_k and the second
+ * integral is d_i = spacing * sum_{k <= i} v_k. Both integrals are computed in
+ * a single pass over the input.
+ * @param[in] input Pointer to num_records records of length values each,
+ *                  stored contiguously one after another
+ * @param[out] first_integral Pointer to location to write first integrals to,
+ *                            with the same layout as the input. May be null if
+ *                            not needed, or the same as input.
+ * @param[out] second_integral Pointer to location to write second integrals
+ *                             to, with the same layout as the input. May be
+ *                             the same as input.
+ * @param[in] length Number of values in each record
+ * @param[in] num_records Number of records
+ * @param[in] spacing Spacing between data points
+ * @param[in] scale Factor applied to input values, such as a unit conversion.
+ *                  Defaults to 1.0.
+ */
+void cumulative_double_integral(const double* input, double* first_integral,
+                                double* second_integral, std::size_t length,
+                                std::size_t num_records, double spacing,
+                                double scale = 1.0);
+
+/**
+ * Integrate records twice in place using running sums
+ * @param[in, out] records Matrix with one record per column, overwritten with
+ *                         the second integrals
+ * @param[in] spacing Spacing between data points
+ * @param[in] scale Factor applied to input values. Defaults to 1.0.
+ */
+void cumulative_double_integral(Eigen::MatrixXd& records, double spacing,
+                                double scale = 1.0);
+
+/**
+ * Calculate the cumulative energy of records, scale * sum_{k <= i} x_k^2. With
+ * scale equal to pi / (2 g) times the time step this is the Arias intensity of
+ * an acceleration time history.
+ * @param[in] input Pointer to num_records records of length values each,
+ *                  stored contiguously one after another
+ * @param[out] output Pointer to location to write cumulative energies to, with
+ *                    the same layout as the input. May be the same as input.
+ * @param[in] length Number of values in each record
+ * @param[in] num_records Number of records
+ * @param[in] scale Factor applied to squared input values
+ */
+void cumulative_energy(const double* input, double* output, std::size_t length,
+                       std::size_t num_records, double scale);
+
+/**
+ * Calculate the cumulative energy of records in place
+ * @param[in, out] records Matrix with one record per column, overwritten with
+ *                         the cumulative energies
+ * @param[in] scale Factor applied to squared input values
+ */
+void cumulative_energy(Eigen::MatrixXd& records, double scale);
+
+/**
+ * Calculate the Arias intensity of an acceleration time history,
+ * pi / (2 g) times the time step times the sum of squared accelerations
+ * @param[in] acceleration Acceleration time history
+ * @param[in] time_step Time step between acceleration values
+ * @param[in] gravity Acceleration of gravity in units of the input
+ *                    accelerations. Defaults to 9.81 for m/s^2.
+ * @return Arias intensity in units of the input accelerations times seconds
+ */
+double arias_intensity(const std::vector<double>& acceleration,
+                       double time_step, double gravity = 9.81);
+
+/**
+ * Calculate the one-sided periodogram estimate of the power spectral density
+ * of a time history at specified frequencies, 2 dt / N |sum_n x_n e^{-i w n
+ * dt}|^2, by evaluating the discrete time Fourier transform at each frequency
+ * @param[in] time_history Time history to estimate spectral density of
+ * @param[in] time_step Time step between values of time history
+ * @param[in] frequencies Circular frequencies in rad/s at which to evaluate
+ *                        spectral density
+ * @return Vector containing spectral density at each frequency
+ */
+Eigen::VectorXd periodogram(const std::vector<double>& time_history,
+                            double time_step,
+                            const Eigen::VectorXd& frequencies);
+
+/**
+ * Find the first index at which a record reaches each of several thresholds
+ * in a single pass over the record
+ * @param[in] values Pointer to record values
+ * @param[in] length Number of values in record
+ * @param[in] thresholds Thresholds to search for, in any order
+ * @param[in] relative If true, thresholds are fractions of the last value in
+ *                     the record, such as 0.05 and 0.95 of the total Arias
+ *                     intensity for a cumulative energy record. Defaults to
+ *                     false.
+ * @return Index of first value greater than or equal to each threshold, in the
+ *         same order as the thresholds. Equal to length if the threshold is
+ *         never reached.
+ */
+std::vector<std::size_t> threshold_crossings(
+    const double* values, std::size_t length,
+    const std::vector<double>& thresholds, bool relative = false);
+
+/**
+ * Find the first index at which each record reaches each of several
+ * thresholds
+ * @param[in] records Matrix with one record per column
+ * @param[in] thresholds Thresholds to search for, in any order
+ * @param[in] relative If true, thresholds are fractions of the last value in
+ *                     each record. Defaults to false.
+ * @return Matrix with one row per threshold and one column per record
+ *         containing the crossing indices
+ */
+Eigen::Matrix<std::size_t, Eigen::Dynamic, Eigen::Dynamic> threshold_crossings(
+    const Eigen::MatrixXd& records, const std::vector<double>& thresholds,
+    bool relative = false);
+
 /**
  * Fit polynomial to data, forcing y-intercept to zero
  * @param[in] points Vector of evaluation points
@@ -173,6 +649,114 @@ Eigen::VectorXd evaluate_polynomial(const Eigen::VectorXd& coefficients,
 std::vector<double> evaluate_polynomial(const std::vector<double>& coefficients,
                                         const std::vector<double>& points);
 
+/**
+ * Evaluate polynomial described by input coefficients at input points using
+ * Horner's scheme, writing directly to caller-owned output storage
+ * @param[in] coefficients Pointer to coefficients of polynomial terms ordered
+ *                         in descending power
+ * @param[in] num_coefficients Number of coefficients
+ * @param[in] points Pointer to points at which to evaluate polynomial
+ * @param[in, out] evaluations Pointer to location to write num_points
+ *                             polynomial values to
+ * @param[in] num_points Number of points
+ */
+void evaluate_polynomial(const double* coefficients,
+                         std::size_t num_coefficients, const double* points,
+                         double* evaluations, std::size_t num_points);
+
+/**
+ * Evaluate polynomial and its derivatives at input points in a single pass
+ * using extended Horner's scheme
+ * @param[in] coefficients Coefficients of polynomial terms ordered in
+ *                         descending power
+ * @param[in] points Vector of points at which to evaluate polynomial
+ * @param[in] num_derivatives Number of derivatives to evaluate
+ * @return Matrix with one row per point where column k contains the k-th
+ *         derivative of the polynomial, starting with the polynomial itself
+ */
+Eigen::MatrixXd evaluate_polynomial_derivatives(
+    const Eigen::VectorXd& coefficients, const Eigen::VectorXd& points,
+    unsigned int num_derivatives);
+
+/**
+ * Evaluate one polynomial per record, or one of its derivatives, at shared
+ * input points
+ * @param[in] coefficients Matrix where each column contains coefficients of
+ *                         polynomial terms for one record ordered in
+ *                         descending power
+ * @param[in] points Vector of points at which to evaluate polynomials
+ * @param[in] derivative Order of derivative to evaluate. Defaults to 0, in
+ *                       which case the polynomials themselves are evaluated.
+ * @return Matrix with one row per point and one column per record
+ */
+Eigen::MatrixXd evaluate_polynomial_batch(const Eigen::MatrixXd& coefficients,
+                                          const Eigen::VectorXd& points,
+                                          unsigned int derivative = 0);
+
+/**
+ * Estimate means of ensemble statistics using a control variate with known
+ * mean. Each statistic is corrected by its sample regression on the control,
+ * which reduces the variance of the estimate by the fraction of variance the
+ * control explains.
+ * @param[in] samples Matrix with one row per realization and one column per
+ *                    statistic
+ * @param[in] controls Value of control variate for each realization
+ * @param[in] control_mean Known expected value of control variate
+ * @return Vector containing estimated mean of each statistic
+ */
+Eigen::VectorXd control_variate_mean(const Eigen::MatrixXd& samples,
+                                     const Eigen::VectorXd& controls,
+                                     double control_mean);
+
+/**
+ * Compute likelihood ratios of realizations drawn from a proposal
+ * multivariate normal distribution with respect to a target multivariate
+ * normal distribution. These are the weights that make estimates based on
+ * proposal realizations unbiased for the target distribution.
+ * @param[in] realizations Matrix containing one realization per column
+ * @param[in] means Vector of mean values for target distribution
+ * @param[in] cov Covariance matrix of target distribution
+ * @param[in] proposal_means Vector of mean values for proposal distribution
+ * @param[in] proposal_cov Covariance matrix of proposal distribution
+ * @return Vector containing ratio of target to proposal density for each
+ *         realization
+ */
+Eigen::VectorXd normal_likelihood_ratios(const Eigen::MatrixXd& realizations,
+                                         const Eigen::VectorXd& means,
+                                         const Eigen::MatrixXd& cov,
+                                         const Eigen::VectorXd& proposal_means,
+                                         const Eigen::MatrixXd& proposal_cov);
+
+/**
+ * Estimate the ratio of the probability that a realization of a proposal
+ * multivariate normal distribution is accepted to the probability that a
+ * realization of a target multivariate normal distribution is accepted.
+ * Scaling likelihood ratios by this value gives weights of the accepted
+ * target distribution with respect to the accepted proposal. Both
+ * distributions are sampled from the same unit normal values, drawn in
+ * blocks from the input stream until each has at least 400 accepted
+ * realizations or 65536 realizations have been drawn. Each acceptance probability p estimated from n
+ * realizations has relative standard error sqrt((1 - p) / (n p)), which is
+ * at most about 5% once 400 realizations are accepted, and the relative
+ * standard error of the ratio is at most the root sum of squares of both.
+ * The error scales all weights by the same factor, so self-normalized
+ * estimates are not affected.
+ * @param[in] accept Function that flags which columns of a matrix of
+ *                   realizations are accepted
+ * @param[in] means Vector of mean values for target distribution
+ * @param[in] cov Covariance matrix of target distribution
+ * @param[in] proposal_means Vector of mean values for proposal distribution
+ * @param[in] proposal_cov Covariance matrix of proposal distribution
+ * @param[in, out] stream Random stream to draw unit normal values from
+ * @return Estimated ratio of proposal to target acceptance probability
+ */
+double acceptance_ratio(
+    const std::function<Eigen::Array<bool, 1, Eigen::Dynamic>(
+        const Eigen::MatrixXd&)>& accept,
+    const Eigen::VectorXd& means, const Eigen::MatrixXd& cov,
+    const Eigen::VectorXd& proposal_means, const Eigen::MatrixXd& proposal_cov,
+    RandomStream& stream);
+
 /**
  * Abstract base class for random number generators
  */
@@ -212,6 +796,62 @@ class RandomGenerator {
       const Eigen::VectorXd& means, const Eigen::MatrixXd& cov,
       unsigned int cases = 1) = 0;
 
+  /**
+   * Get single precision multivariate random realization. Default
+   * implementation generates realizations in double precision and converts
+   * them, so results match the double precision overload for the same seed.
+   * @param[in, out] random_numbers Matrix to store generated random numbers to
+   * @param[in] means Vector of mean values for random variables
+   * @param[in] cov Covariance matrix of for random variables
+   * @param[in] cases Number of cases to generate
+   * @return Returns true if no issues were encountered in Cholesky
+   *         decomposition of covariance matrix, returns false otherwise
+   */
+  virtual bool generate(
+      Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic>& random_numbers,
+      const Eigen::VectorXf& means, const Eigen::MatrixXf& cov,
+      unsigned int cases = 1);
+
+  /**
+   * Prepare generator to draw realizations of a fixed distribution, so that
+   * repeated draws do not need to process the input distribution again.
+   * Default implementation stores the mean values and covariance matrix for
+   * use in draw.
+   * @param[in] means Vector of mean values for random variables
+   * @param[in] cov Covariance matrix of for random variables
+   * @return Returns true if no issues were encountered in preparing the
+   *         distribution, returns false otherwise
+   */
+  virtual bool prepare(const Eigen::VectorXd& means,
+                       const Eigen::MatrixXd& cov);
+
+  /**
+   * Get multivariate random realizations of the distribution passed to the
+   * most recent call to prepare. Default implementation calls generate with
+   * the stored mean values and covariance matrix.
+   * @param[in, out] random_numbers Matrix to store generated random numbers to
+   * @param[in] cases Number of cases to generate
+   */
+  virtual void draw(
+      Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>& random_numbers,
+      unsigned int cases = 1);
+
+  /**
+   * Get multivariate random realizations of the prepared distribution
+   * truncated to a box. Candidates are drawn in blocks that are oversampled
+   * based on the acceptance rate observed so far and are filtered with
+   * vectorized bound checks. Accepted realizations are stored in the order
+   * they were drawn.
+   * @param[in, out] random_numbers Matrix to store generated random numbers to
+   * @param[in] lower Lower bound for each random variable
+   * @param[in] upper Upper bound for each random variable
+   * @param[in] cases Number of cases to generate
+   */
+  virtual void draw_truncated(
+      Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>& random_numbers,
+      const Eigen::VectorXd& lower, const Eigen::VectorXd& upper,
+      unsigned int cases);
+
   /**
    * Get the class name
    * @return Class name
@@ -221,6 +861,8 @@ class RandomGenerator {
  protected:
   int seed_ = static_cast<int>(
       std::time(nullptr)); /**< Seed value to use in random number generator */
+  Eigen::VectorXd prepared_means_; /**< Mean values passed to prepare */
+  Eigen::MatrixXd prepared_cov_; /**< Covariance matrix passed to prepare */
 };
 }  // namespace numeric_utils
 
@@ -0,0 +1,85 @@
+#ifndef _ONLINE_ESTIMATOR_H_
+#define _ONLINE_ESTIMATOR_H_
+
+#include <Eigen/Dense>
+
+namespace numeric_utils {
+
+/**
+ * Online estimator of the mean values of a set of statistics using Welford's
+ * algorithm. Samples are added one at a time, so an ensemble can be
+ * generated until the confidence intervals of the mean values are narrow
+ * enough. Confidence intervals use the Student's t critical value with one
+ * less degree of freedom than the number of samples, so intervals keep their
+ * nominal coverage for small ensembles of normally distributed statistics.
+ */
+class OnlineEstimator {
+ public:
+  /**
+   * @constructor Default constructor
+   */
+  OnlineEstimator() = default;
+
+  /**
+   * Add sample of statistics to estimator. The first sample sets the number
+   * of statistics.
+   * @param[in] sample Value of each statistic for sample
+   */
+  void add(const Eigen::VectorXd& sample);
+
+  /**
+   * Get number of samples added to estimator
+   * @return Number of samples
+   */
+  unsigned int count() const { return count_; };
+
+  /**
+   * Get estimated mean values of statistics
+   * @return Vector containing mean value of each statistic
+   */
+  const Eigen::VectorXd& mean() const { return mean_; };
+
+  /**
+   * Get unbiased sample variances of statistics
+   * @return Vector containing sample variance of each statistic, which is
+   *         zero until two samples have been added
+   */
+  Eigen::VectorXd variance() const;
+
+  /**
+   * Get half-widths of confidence intervals of mean values
+   * @param[in] confidence Confidence level of intervals
+   * @return Vector containing half-width of confidence interval of mean of
+   *         each statistic
+   */
+  Eigen::VectorXd half_widths(double confidence) const;
+
+  /**
+   * Get largest half-width of confidence intervals of mean values relative
+   * to the magnitude of the mean values
+   * @param[in] confidence Confidence level of intervals
+   * @return Largest relative half-width, which is infinite until two samples
+   *         have been added
+   */
+  double relative_precision(double confidence) const;
+
+  /**
+   * Check whether confidence intervals of all mean values are within the
+   * relative tolerance
+   * @param[in] tolerance Largest allowed half-width of confidence intervals
+   *                      relative to magnitude of mean values
+   * @param[in] confidence Confidence level of intervals
+   * @return Returns true if all mean values are within tolerance, false
+   *         otherwise
+   */
+  bool converged(double tolerance, double confidence) const;
+
+ private:
+  unsigned int count_ = 0; /**< Number of samples added */
+  Eigen::VectorXd mean_; /**< Running mean of statistics */
+  Eigen::VectorXd squared_deviations_; /**< Running sum of squared deviations
+                                          from the mean */
+};
+}  // namespace numeric_utils
+
+#endif  // _ONLINE_ESTIMATOR_H_
@@ -0,0 +1,89 @@
+#ifndef _QUANTILE_TABLE_H_
+#define _QUANTILE_TABLE_H_
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+#include "distribution.h"
+
+namespace stochastic {
+
+/**
+ * Precomputed table for transforming values from standard normal space to a
+ * distribution, which replaces iterative quantile evaluation with a lookup.
+ * The transformation is tabulated on a uniform grid of standard normal values
+ * as piecewise cubic Hermite segments using exact slopes, so each lookup is a
+ * single index computation and polynomial evaluation. The number of segments
+ * is doubled until the interpolation error at points between nodes is within
+ * the requested tolerance. Values outside the tabulated range are
+ * transformed exactly.
+ */
+class QuantileTable {
+ public:
+  /**
+   * @constructor Delete default constructor
+   */
+  QuantileTable() = delete;
+
+  /**
+   * @constructor Build table for transformation
+   * @param[in] transform Exact transformation from standard normal space to
+   *                      distribution, used to build table and as fallback
+   *                      outside tabulated range
+   * @param[in] density Probability density function of distribution, used to
+   *                    compute slopes of transformation
+   * @param[in] tolerance Maximum interpolation error, relative to the
+   *                      magnitude of transformed values when larger than 1
+   */
+  QuantileTable(std::function<double(double)> transform,
+                const std::function<double(double)>& density,
+                double tolerance);
+
+  /**
+   * Check whether table meets requested tolerance. Tables that do not meet
+   * the tolerance should not be used.
+   * @return True if table is valid, false otherwise
+   */
+  bool valid() const { return valid_; };
+
+  /**
+   * Get number of tabulated segments
+   * @return Number of segments
+   */
+  std::size_t num_segments() const { return coefficients_.size() / 4; };
+
+  /**
+   * Transform value from standard normal space to distribution
+   * @param[in] value Value in standard normal space
+   * @return Transformed value
+   */
+  double evaluate(double value) const;
+
+  /**
+   * Transform values from standard normal space to distribution in place
+   * @param[in, out] values Values in standard normal space, which are
+   *                        overwritten with the transformed values
+   */
+  void transform(ValuesRef values) const;
+
+ private:
+  /**
+   * Tabulate transformation using input number of segments and check
+   * interpolation error
+   * @param[in] density Probability density function of distribution
+   * @param[in] num_segments Number of segments to tabulate
+   * @param[in] tolerance Maximum interpolation error
+   * @return True if interpolation error is within tolerance, false otherwise
+   */
+  bool tabulate(const std::function<double(double)>& density,
+                std::size_t num_segments, double tolerance);
+
+  std::function<double(double)> transform_; /**< Exact transformation */
+  double inv_step_; /**< Inverse of spacing between nodes */
+  std::vector<double> coefficients_; /**< Cubic polynomial coefficients in
+                                        ascending order, 4 per segment */
+  bool valid_; /**< Whether table meets tolerance */
+};
+}  // namespace stochastic
+
+#endif  // _QUANTILE_TABLE_H_
@@ -0,0 +1,115 @@
+#ifndef _RANDOM_STREAM_H_
+#define _RANDOM_STREAM_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace numeric_utils {
+
+/**
+ * Philox4x32-10 counter-based random number generator (Salmon et al., 2011).
+ * Each output block is a keyed bijection of a 128-bit counter, so any block
+ * can be computed directly from its counter without generating the blocks
+ * before it and without any shared state.
+ */
+class Philox4x32 {
+ public:
+  typedef std::array<std::uint32_t, 4> Counter; /**< 128-bit counter */
+  typedef std::array<std::uint32_t, 2> Key; /**< 64-bit key */
+
+  /**
+   * Compute output block for input counter and key
+   * @param[in] counter Counter to encrypt
+   * @param[in] key Key to encrypt counter with
+   * @return Block of four random 32-bit integers
+   */
+  static Counter block(const Counter& counter, const Key& key);
+};
+
+/**
+ * Stream of random 32-bit integers keyed by seed, event, component and stream
+ * index, built on the Philox4x32 generator. Streams with different keys are
+ * statistically independent, so each event and component of a simulation can
+ * be generated on any thread in any order and still reproduce the same values
+ * for the same seed. Satisfies the uniform random bit generator requirements,
+ * so streams can be used with Boost and standard library distributions.
+ */
+class RandomStream {
+ public:
+  typedef std::uint32_t result_type; /**< Type of generated values */
+
+  /**
+   * @constructor Construct stream for input key
+   * @param[in] seed Seed shared by all streams of a simulation
+   * @param[in] event Index of event the stream is used for
+   * @param[in] component Index of component within event, such as the
+   *                      direction or location of a time history. Defaults
+   *                      to 0.
+   * @param[in] stream Index of stream within component, used to separate
+   *                   independent uses within the same component. Defaults
+   *                   to 0.
+   */
+  RandomStream(std::uint64_t seed, std::uint32_t event,
+               std::uint32_t component = 0, std::uint32_t stream = 0);
+
+  /**
+   * Get next random integer in stream
+   * @return Random integer uniformly distributed between min() and max()
+   */
+  result_type operator()();
+
+  /**
+   * Get next random double in stream
+   * @return Random value uniformly distributed on [0, 1) with 53 random bits
+   */
+  double uniform();
+
+  /**
+   * Fill buffer with standard normal values using the Box-Muller transform.
+   * Uniform values are drawn for the whole block first and then transformed
+   * with vectorized array operations.
+   * @param[out] values Pointer to location to write normal values to
+   * @param[in] count Number of values to generate
+   */
+  void fill_normal(double* values, std::size_t count);
+
+  /**
+   * Skip ahead in stream without generating the skipped values
+   * @param[in] count Number of integers to skip
+   */
+  void discard(std::uint64_t count);
+
+  /**
+   * Get the smallest value produced by the stream
+   * @return Smallest value
+   */
+  static constexpr result_type min() { return 0; }
+
+  /**
+   * Get the largest value produced by the stream
+   * @return Largest value
+   */
+  static constexpr result_type max() { return 0xFFFFFFFF; }
+
+ private:
+  /**
+   * Generate block at current counter position
+   */
+  void refill();
+
+  Philox4x32::Key key_; /**< Key derived from seed */
+  Philox4x32::Counter counter_; /**< Block index, event, component, stream */
+  Philox4x32::Counter block_; /**< Current block of outputs */
+  unsigned int position_; /**< Position of next output in current block */
+};
+
+/**
+ * Get a seed for random streams that differs between calls, for simulations
+ * where no seed has been specified. Thread-safe.
+ * @return Seed value
+ */
+std::uint64_t unique_seed();
+}  // namespace numeric_utils
+
+#endif  // _RANDOM_STREAM_H_
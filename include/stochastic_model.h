@@ -1,11 +1,32 @@
 #ifndef _STOCHASTIC_MODEL_H_
 #define _STOCHASTIC_MODEL_H_
 
+#include <functional>
+#include <stdexcept>
 #include <string>
+#include <vector>
+#include <Eigen/Dense>
 #include "json_object.h"
+#include "online_estimator.h"
 
 namespace stochastic {
 
+/**
+ * Statistic of a time history of an event, such as its Arias intensity or
+ * its power spectral density at chosen frequencies, evaluated from the time
+ * history as output by a model and its time step
+ */
+using EventStatistic =
+    std::function<Eigen::VectorXd(const std::vector<double>&, double)>;
+
+/**
+ * Floating point precision used for time history synthesis
+ */
+enum class Precision {
+  Single, /**< Synthesize and output time histories in single precision */
+  Double  /**< Synthesize and output time histories in double precision */
+};
+
 /**
  * Abstract base class for stochastic models
  */
@@ -37,6 +58,119 @@ class StochasticModel {
    */
   std::string model_name() const { return model_name_; };
 
+  /**
+   * Set floating point precision used to synthesize time histories. Models
+   * that do not support single precision ignore this setting.
+   * @param[in] precision Precision to use for subsequent generation
+   */
+  void set_precision(Precision precision) { precision_ = precision; };
+
+  /**
+   * Get floating point precision used to synthesize time histories
+   * @return Precision used for generation
+   */
+  Precision precision() const { return precision_; };
+
+  /**
+   * Set whether realizations are generated in antithetic pairs, where the
+   * second realization of each pair is driven by the negated random inputs
+   * of the first. Since models are linear in their random inputs, the second
+   * time history is the negation of the first. Variance is only reduced for
+   * the odd part of a statistic of the time history, such as its value at a
+   * given time. Even statistics, such as Arias intensity, power spectral
+   * density and spectral ordinates, are identical within a pair, so a pair
+   * gives no more information on them than a single realization and
+   * ensembles must not be made smaller on account of this setting.
+   * Models that do not support antithetic sampling ignore this setting.
+   * @param[in] antithetic Whether to generate antithetic pairs
+   */
+  void set_antithetic(bool antithetic) { antithetic_ = antithetic; };
+
+  /**
+   * Get whether realizations are generated in antithetic pairs
+   * @return True if realizations are generated in antithetic pairs, false
+   *         otherwise
+   */
+  bool antithetic() const { return antithetic_; };
+
+  /**
+   * Set proposal distribution for importance sampling of model parameters.
+   * Normal model parameters are drawn with mean values shifted towards the
+   * region of interest and covariance scaled, and each generated event
+   * carries the likelihood ratio of the model distribution to the proposal
+   * as its weight. Weights are density ratios scaled by the ratio of
+   * estimated acceptance probabilities of realizations the model rejects,
+   * and are not normalized. The estimate is drawn from a random stream
+   * separate from the model parameters, and its error is described in
+   * numeric_utils::acceptance_ratio.
+   * Models that do not sample model parameters ignore this setting.
+   * @param[in] proposal_shift Shift of mean value of each normal model
+   *                           parameter in units of its standard deviation
+   * @param[in] proposal_scale Factor on standard deviations of proposal.
+   *                           Defaults to 1.0.
+   */
+  virtual void set_importance_sampling(const Eigen::VectorXd& proposal_shift,
+                                       double proposal_scale = 1.0) {
+    if (proposal_scale <= 0.0) {
+      throw std::runtime_error(
+          "\nERROR: In stochastic::StochasticModel::set_importance_sampling: "
+          "Proposal scale must be positive\n");
+    }
+    proposal_shift_ = proposal_shift;
+    proposal_scale_ = proposal_scale;
+  };
+
+  /**
+   * Get whether model parameters are importance sampled
+   * @return True if model parameters are drawn from a proposal distribution,
+   *         false otherwise
+   */
+  bool importance_sampling() const { return proposal_shift_.size() > 0; };
+
+  /**
+   * Set adaptive ensemble size, where events are generated incrementally
+   * until the confidence intervals of the mean values of the target
+   * statistics are within a relative tolerance. The ensemble size requested
+   * on construction is the largest that is generated. Each sample is the
+   * statistic summed over the time series of an event and averaged over the
+   * events that share a set of model parameters, so samples are
+   * independent. Output contains the achieved precision in an
+   * "AdaptiveEnsemble" entry. Models that generate a single event per call
+   * throw an exception instead of ignoring the requested precision.
+   * @param[in] statistic Target statistics of each time series of an event
+   * @param[in] tolerance Largest allowed half-width of confidence intervals
+   *                      relative to magnitude of mean values
+   * @param[in] min_samples Number of samples generated before checking
+   *                        convergence, which is at least 2. Intervals use
+   *                        the Student's t critical value, so they stay
+   *                        valid for small numbers of samples. Defaults to
+   *                        10.
+   * @param[in] confidence Confidence level of intervals. Defaults to 0.95.
+   */
+  virtual void set_adaptive_ensemble(EventStatistic statistic,
+                                     double tolerance,
+                                     unsigned int min_samples = 10,
+                                     double confidence = 0.95) {
+    if (tolerance <= 0.0 || confidence <= 0.0 || confidence >= 1.0) {
+      throw std::runtime_error(
+          "\nERROR: In stochastic::StochasticModel::set_adaptive_ensemble: "
+          "Tolerance must be positive and confidence between 0 and 1\n");
+    }
+    adaptive_statistic_ = statistic;
+    adaptive_tolerance_ = tolerance;
+    adaptive_min_samples_ = min_samples < 2 ? 2 : min_samples;
+    adaptive_confidence_ = confidence;
+  };
+
+  /**
+   * Get whether ensemble size is adaptive
+   * @return True if events are generated until target statistics converge,
+   *         false otherwise
+   */
+  bool adaptive_ensemble() const {
+    return static_cast<bool>(adaptive_statistic_);
+  };
+
   /**
    * Generate loading based on stochastic model and store
    * outputs as JSON object
@@ -64,7 +198,88 @@ class StochasticModel {
                         bool units = false) = 0;
 
  protected:
+  /**
+   * Evaluate adaptive ensemble statistic summed over time series of event
+   * @tparam T Floating point type of time series
+   * @param[in] time_series Time series of event
+   * @param[in] time_step Time step of time series
+   * @return Vector containing value of each target statistic
+   */
+  template <typename T>
+  Eigen::VectorXd event_statistic(const std::vector<std::vector<T>>& time_series,
+                                  double time_step) const {
+    Eigen::VectorXd total;
+    for (auto const& series : time_series) {
+      Eigen::VectorXd value = adaptive_statistic_(
+          std::vector<double>(series.begin(), series.end()), time_step);
+      if (total.size() == 0) {
+        total = value;
+      } else {
+        total += value;
+      }
+    }
+    return total;
+  };
+
+  /**
+   * Check whether adaptive ensemble has enough samples and has converged
+   * @param[in] estimator Estimator of target statistics
+   * @return Returns true if generation can stop, false otherwise
+   */
+  bool adaptive_converged(
+      const numeric_utils::OnlineEstimator& estimator) const {
+    return estimator.count() >= adaptive_min_samples_ &&
+           estimator.converged(adaptive_tolerance_, adaptive_confidence_);
+  };
+
+  /**
+   * Create output describing precision achieved by adaptive ensemble
+   * @param[in] estimator Estimator of target statistics
+   * @param[in] num_events Number of events generated
+   * @return JsonObject containing number of samples and events, whether
+   *         statistics converged, and their means and confidence intervals
+   */
+  utilities::JsonObject adaptive_summary(
+      const numeric_utils::OnlineEstimator& estimator,
+      unsigned int num_events) const {
+    auto summary = utilities::JsonObject();
+    Eigen::VectorXd half_widths =
+        estimator.count() > 0 ? estimator.half_widths(adaptive_confidence_)
+                              : Eigen::VectorXd();
+    summary.add_value("numSamples", estimator.count());
+    summary.add_value("numEvents", num_events);
+    summary.add_value("converged", adaptive_converged(estimator));
+    summary.add_value("confidence", adaptive_confidence_);
+    summary.add_value("tolerance", adaptive_tolerance_);
+    summary.add_value("relativePrecision",
+                      estimator.relative_precision(adaptive_confidence_));
+    summary.add_value("means",
+                      std::vector<double>(estimator.mean().data(),
+                                          estimator.mean().data() +
+                                              estimator.mean().size()));
+    summary.add_value("halfWidths",
+                      std::vector<double>(half_widths.data(),
+                                          half_widths.data() +
+                                              half_widths.size()));
+    return summary;
+  };
+
   std::string model_name_ = "StochasticModel"; /**< Name of stochastic model */  
+  Precision precision_ =
+      Precision::Double; /**< Precision used for time history synthesis */
+  bool antithetic_ = false; /**< Whether to generate antithetic pairs */
+  Eigen::VectorXd proposal_shift_; /**< Shift of proposal mean values in
+                                      standard deviations, empty when not
+                                      importance sampling */
+  double proposal_scale_ = 1.0; /**< Factor on proposal standard deviations */
+  EventStatistic adaptive_statistic_; /**< Target statistics of adaptive
+                                         ensemble, empty when ensemble size
+                                         is fixed */
+  double adaptive_tolerance_ = 0.05; /**< Relative tolerance on confidence
+                                        intervals of adaptive ensemble */
+  unsigned int adaptive_min_samples_ = 10; /**< Samples generated before
+                                              checking convergence */
+  double adaptive_confidence_ = 0.95; /**< Confidence level of intervals */
 };
 }  // namespace stochastic
 
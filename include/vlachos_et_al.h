@@ -1,16 +1,30 @@
 #ifndef _VLACHOS_ET_AL_H_
 #define _VLACHOS_ET_AL_H_
 
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
 #include <Eigen/Dense>
+#include "convolution_kernel.h"
 #include "distribution.h"
 #include "json_object.h"
 #include "numeric_utils.h"
 #include "stochastic_model.h"
 
 namespace stochastic {
+/**
+ * Method used to synthesize time histories from the evolutionary power
+ * spectrum
+ */
+enum class SynthesisMethod {
+  Exact, /**< Evaluate spectral representation sum at every time step */
+  Interpolated /**< Interpolate amplitudes linearly between frames on a
+                  coarse time grid and evaluate stationary sum for each frame
+                  with FFTs */
+};
+
 /**
  * Stochastic model for generating scenario specific ground
  * motion time histories. This is based on the paper:
@@ -41,10 +55,18 @@ class VlachosEtAl : public StochasticModel {
    *                        generated.
    * @param[in] num_sims Number of simulated ground motion time histories that
    *                     should be generated per evolutionary power
+   * @param[in] sample_generator Name of random number generator registered in
+   *                             factory used to sample model parameters.
+   *                             Defaults to "MultivariateNormal", while
+   *                             "MultivariateNormalLHS" uses Latin hypercube
+   *                             sampling. Realizations redrawn because their
+   *                             modal frequencies are not ordered are not
+   *                             stratified.
    */
   VlachosEtAl(double moment_magnitude, double rupture_distance, double vs30,
               double orientation, unsigned int num_spectra,
-              unsigned int num_sims);
+              unsigned int num_sims,
+              const std::string& sample_generator = "MultivariateNormal");
 
   /**
    * @constructor Construct scenario specific ground motion model based on input
@@ -63,10 +85,52 @@ class VlachosEtAl : public StochasticModel {
    *                     should be generated per evolutionary power
    * @param[in] seed_value Value to seed random variables with to ensure
    *                       repeatability
+   * @param[in] sample_generator Name of random number generator registered in
+   *                             factory used to sample model parameters.
+   *                             Defaults to "MultivariateNormal", while
+   *                             "MultivariateNormalLHS" uses Latin hypercube
+   *                             sampling. Realizations redrawn because their
+   *                             modal frequencies are not ordered are not
+   *                             stratified.
+   */
+  VlachosEtAl(double moment_magnitude, double rupture_distance, double vs30,
+              double orientation, unsigned int num_spectra,
+              unsigned int num_sims, int seed_value,
+              const std::string& sample_generator = "MultivariateNormal");  
+
+  /**
+   * @constructor Construct scenario specific ground motion model based on input
+   * parameters with specified discretization and frequency truncation
+   * @param[in] moment_magnitude Moment magnitude of earthquake scenario
+   * @param[in] rupture_distance Closest-to-site rupture distance in kilometers
+   * @param[in] vs30 Soil shear wave velocity averaged over top 30 meters in
+   *                 meters per second
+   * @param[in] orientation Orientation of acceleration relative to global
+   *                        coordinates. Represents counter-clockwise angle (in
+   *                        degrees) away from x-axis rotating around z-axis in
+   *                        right-handed coordinate system.
+   * @param[in] num_spectra Number of evolutionary power spectra that should be
+   *                        generated.
+   * @param[in] num_sims Number of simulated ground motion time histories that
+   *                     should be generated per evolutionary power
+   * @param[in] seed_value Value to seed random variables with to ensure
+   *                       repeatability
+   * @param[in] time_step Time step in seconds
+   * @param[in] freq_step Frequency step in radians per second
+   * @param[in] cutoff_freq Highest frequency in radians per second, which may
+   *                        not exceed the Nyquist frequency of the time step
+   * @param[in] energy_threshold Relative energy threshold for truncating the
+   *                             frequency range, where 0 retains all
+   *                             frequencies
+   * @param[in] sample_generator Name of random number generator registered in
+   *                             factory used to sample model parameters.
+   *                             Defaults to "MultivariateNormal".
    */
   VlachosEtAl(double moment_magnitude, double rupture_distance, double vs30,
               double orientation, unsigned int num_spectra,
-              unsigned int num_sims, int seed_value);  
+              unsigned int num_sims, int seed_value, double time_step,
+              double freq_step, double cutoff_freq, double energy_threshold,
+              const std::string& sample_generator = "MultivariateNormal");
 
   /**
    * @destructor Virtual destructor
@@ -111,16 +175,151 @@ class VlachosEtAl : public StochasticModel {
                 const std::string& output_location,
                 bool units = false) override;
 
+  /**
+   * Set proposal distribution for importance sampling of model parameters
+   * and redraw the model parameters of all spectra from it. Events include
+   * the likelihood weight of their spectrum. Realizations that would be
+   * rejected because the dominant frequency or mean of mode 1 exceeds that
+   * of mode 2 are redrawn from the proposal.
+   * @param[in] proposal_shift Shift of mean value of each of the 18 normal
+   *                           model parameters in units of its standard
+   *                           deviation
+   * @param[in] proposal_scale Factor on standard deviations of proposal.
+   *                           Defaults to 1.0.
+   */
+  void set_importance_sampling(const Eigen::VectorXd& proposal_shift,
+                               double proposal_scale = 1.0) override;
+
+  /**
+   * Get likelihood ratio weights of the model parameters of each spectrum.
+   * Weights account for rejecting realizations with unordered modes and are
+   * not normalized.
+   * @return Vector containing weight of each spectrum, which are all 1.0
+   *         when model parameters are not importance sampled
+   */
+  const Eigen::VectorXd& likelihood_weights() const {
+    return likelihood_weights_;
+  };
+
+  /**
+   * Set method used to synthesize time histories. Interpolated synthesis
+   * chooses the widest spacing of amplitude frames for which the relative
+   * root-mean-square error of the interpolated amplitudes, which equals the
+   * expected relative root-mean-square error of the time history over random
+   * phase angles, does not exceed the tolerance. Exact synthesis is used
+   * instead when frames would be too closely spaced to reduce work.
+   * @param[in] method Synthesis method
+   * @param[in] tolerance Relative error tolerance of interpolated synthesis.
+   *                      Defaults to 1.0E-3.
+   */
+  void set_synthesis(SynthesisMethod method, double tolerance = 1.0E-3);
+
+  /**
+   * Get method used to synthesize time histories
+   * @return Synthesis method
+   */
+  SynthesisMethod synthesis() const { return synthesis_; };
+
+  /**
+   * Get relative error tolerance of interpolated synthesis
+   * @return Error tolerance
+   */
+  double synthesis_tolerance() const { return synthesis_tolerance_; };
+
+  /**
+   * Set time and frequency discretization used to synthesize time histories
+   * @param[in] time_step Time step in seconds. Defaults to 0.01.
+   * @param[in] freq_step Frequency step in radians per second. Defaults to
+   *                      0.2.
+   * @param[in] cutoff_freq Highest frequency in radians per second, which
+   *                        may not exceed the Nyquist frequency of the time
+   *                        step. Defaults to 220.0.
+   */
+  void set_discretization(double time_step, double freq_step,
+                          double cutoff_freq);
+
+  /**
+   * Get time step
+   * @return Time step in seconds
+   */
+  double time_step() const { return time_step_; };
+
+  /**
+   * Get frequency step
+   * @return Frequency step in radians per second
+   */
+  double freq_step() const { return freq_step_; };
+
+  /**
+   * Get cutoff frequency
+   * @return Highest frequency in radians per second
+   */
+  double cutoff_freq() const { return cutoff_freq_; };
+
+  /**
+   * Set relative energy threshold for truncating the frequency range of each
+   * power spectrum. Frequency bins at either end of the range, smallest
+   * first, are dropped from synthesis for as long as their energy summed
+   * over time, estimated from every 8th time step, stays within the
+   * threshold times the total energy, so synthesis cost decreases with the
+   * number of dropped bins. Retained bins keep the amplitudes and phase
+   * angles they have without truncation, since the spectrum is normalized
+   * to unit variance over the full frequency range, so truncation only
+   * removes energy.
+   * @param[in] threshold Relative energy threshold, where 0 retains all
+   *                      frequencies. Defaults to 0.
+   */
+  void set_energy_threshold(double threshold);
+
+  /**
+   * Get relative energy threshold for truncating frequency range
+   * @return Energy threshold
+   */
+  double energy_threshold() const { return energy_threshold_; };
+
+  /**
+   * Tabulate quantile functions of model parameters whose transformation from
+   * standard normal space is iterative, so that sampling spectra does not
+   * root-find. Building the tables pays off only when many spectra are
+   * sampled, so model parameters are transformed exactly unless this is
+   * called.
+   * @param[in] tolerance Maximum interpolation error of tables. Defaults to
+   *                      1.0e-9.
+   * @return True if at least one model parameter uses a table, false otherwise
+   */
+  bool tabulate_quantiles(double tolerance = 1.0e-9);
+
   /**
    * Compute a family of time histories for a particular power spectrum
    * @param[in, out] time_histories Location where time histories should be
    *                                stored
    * @param[in] parameters Set of model parameters to use for calculating power
    *                       specturm and time histories
+   * @param[in] family_index Index of family within the event ensemble, which
+   *                         selects the random streams of its time histories.
+   *                         Defaults to 0.
    * @return Returns true if successful, false otherwise
    */
   bool time_history_family(std::vector<std::vector<double>>& time_histories,
-                           const Eigen::VectorXd& parameters) const;
+                           const Eigen::VectorXd& parameters,
+                           unsigned int family_index = 0) const;
+
+  /**
+   * Compute a family of single precision time histories for a particular
+   * power spectrum. The power spectrum and filter are computed in double
+   * precision while synthesis and filtering are done in single precision.
+   * @param[in, out] time_histories Location where time histories should be
+   *                                stored
+   * @param[in] parameters Set of model parameters to use for calculating power
+   *                       specturm and time histories
+   * @param[in] family_index Index of family within the event ensemble, which
+   *                         selects the random streams of its time histories.
+   *                         Defaults to 0.
+   * @return Returns true if successful, false otherwise
+   */
+  bool time_history_family(std::vector<std::vector<float>>& time_histories,
+                           const Eigen::VectorXd& parameters,
+                           unsigned int family_index = 0) const;
 
   /**
    * Simulate fully non-stationary ground motion sample realization based on
@@ -129,9 +328,38 @@ class VlachosEtAl : public StochasticModel {
    * @param[in, out] time_history Location where time history should be stored
    * @param[in] power_spectrum Matrix containing values of power spectrum over
    *                           range of frequencies at specified times.
+   * @param[in] event_index Index of time history within the event ensemble.
+   *                        Phase angles are drawn from the random stream for
+   *                        this index, so any time history can be simulated
+   *                        independently of the others. Defaults to 0.
+   * @param[in] antithetic Whether to shift phase angles by pi, which gives
+   *                       the antithetic counterpart of the time history
+   *                       for the same event index. The counterpart is the
+   *                       negated time history, so even statistics such as
+   *                       Arias intensity are the same for both. Defaults to
+   *                       false.
    */
   void simulate_time_history(std::vector<double>& time_history,
-                             const Eigen::MatrixXd& power_spectrum) const;
+                             const Eigen::MatrixXd& power_spectrum,
+                             unsigned int event_index = 0,
+                             bool antithetic = false) const;
+
+  /**
+   * Simulate fully non-stationary ground motion sample realization in single
+   * precision. Phase angles are drawn from the same random stream as the
+   * double precision overload.
+   * @param[in, out] time_history Location where time history should be stored
+   * @param[in] power_spectrum Matrix containing values of power spectrum over
+   *                           range of frequencies at specified times.
+   * @param[in] event_index Index of time history within the event ensemble.
+   *                        Defaults to 0.
+   * @param[in] antithetic Whether to shift phase angles by pi. Defaults to
+   *                       false.
+   */
+  void simulate_time_history(std::vector<float>& time_history,
+                             const Eigen::MatrixXf& power_spectrum,
+                             unsigned int event_index = 0,
+                             bool antithetic = false) const;
 
   /**
    * Post-process the input time history as described in Vlachos et al. using
@@ -145,6 +373,31 @@ class VlachosEtAl : public StochasticModel {
   bool post_process(std::vector<double>& time_history,
                     const std::vector<double>& filter_imp_resp) const;
 
+  /**
+   * Post-process the input time history as described in Vlachos et al. using
+   * multiple-window estimation technique after Conte & Peng (1997) and
+   * highpass Butterworth filter whose impulse response has already been
+   * prepared for convolution
+   * @param[in, out] time_history Time history to post-process. Post-processed
+   *                              results are also stored here.
+   * @param[in] filter_kernel Prepared impulse response of Butterworth filter
+   * @return Returns true if successful, false otherwise
+   */
+  bool post_process(std::vector<double>& time_history,
+                    const numeric_utils::ConvolutionKernel& filter_kernel) const;
+
+  /**
+   * Post-process the input single precision time history using a prepared
+   * single precision filter kernel
+   * @param[in, out] time_history Time history to post-process. Post-processed
+   *                              results are also stored here.
+   * @param[in] filter_kernel Prepared impulse response of Butterworth filter
+   * @return Returns true if successful, false otherwise
+   */
+  bool post_process(
+      std::vector<float>& time_history,
+      const numeric_utils::BasicConvolutionKernel<float>& filter_kernel) const;
+
   /**
    * Identifies modal frequency parameters for mode 1 and 2
    * @param[in] initial_params Initial set of parameters
@@ -233,6 +486,28 @@ class VlachosEtAl : public StochasticModel {
                        const std::vector<double>& frequencies,
                        const std::vector<double>& highpass_butter) const;
 
+  /**
+   * Calculate evolutionary power spectrum at specific time using bimodal K-T
+   * model, writing directly to caller-owned storage and integrating the
+   * power spectrum over frequency in the same pass
+   * @param[in] parameters Vector of parameters fg_1, zeta_1, S0_1, fg_2, zeta_2
+   *                       and S0_2 for the particular time at which the power
+   *                       spectrum is desired
+   * @param[in] frequencies Vector of frequencies at which to evaluate
+   *                        evolutionary power spectrum
+   * @param[in] highpass_butter Vector of Butterworth filter transfer function
+   *                            energy content at input frequencies
+   * @param[in, out] power_spectrum Pointer to location to write
+   *                                frequencies.size() values of power
+   *                                spectrum to
+   * @return Integral of power spectrum over frequency range computed using
+   *         trapezoid rule
+   */
+  double kt_2(const std::vector<double>& parameters,
+              const std::vector<double>& frequencies,
+              const std::vector<double>& highpass_butter,
+              double* power_spectrum) const;
+
   /**
    * Rotate acceleration based on orientation angle
    * @param[in] acceleration Acceleration to rotate
@@ -245,21 +520,237 @@ class VlachosEtAl : public StochasticModel {
                            std::vector<double>& x_accels,
                            std::vector<double>& y_accels, bool g_units) const;
 
+  /**
+   * Rotate single precision acceleration based on orientation angle
+   * @param[in] acceleration Acceleration to rotate
+   * @param[in, out] x_accels Vector to store x-component of acceleration to
+   * @param[in, out] y_accels Vector to story y-component of acceleration to
+   * @param[in] g_units Indicates that time histories should be returned in
+   *                    units of g
+   */
+  void rotate_acceleration(const std::vector<float>& acceleration,
+                           std::vector<float>& x_accels,
+                           std::vector<float>& y_accels, bool g_units) const;
+
  private:
+  /**
+   * Draw realizations of normal model parameters for all spectra, from the
+   * proposal distribution when importance sampling, compute their likelihood
+   * weights and transform them to physical space
+   */
+  void sample_model_parameters();
+
+  /**
+   * Check whether the dominant frequencies of mode 1 do not exceed those of
+   * mode 2 at any non-dimensional energy and whether the mean of mode 1 does
+   * not exceed that of mode 2
+   * @param[in] parameters Model parameters in physical space
+   * @return Returns true if modes are ordered, false otherwise
+   */
+  bool modes_ordered(const Eigen::VectorXd& parameters) const;
+
+  /**
+   * Generate ground motion time histories in requested precision and store
+   * outputs as JSON object
+   * @tparam T Floating point type used for synthesis and output
+   * @param[in] event_name Name to assign to event
+   * @param[in] units Indicates that time histories should be returned in
+   *                  units of g
+   * @return JsonObject containing time histories
+   */
+  template <typename T>
+  utilities::JsonObject generate_event(const std::string& event_name,
+                                       bool units);
+
+  /**
+   * Compute a family of time histories in requested precision
+   * @tparam T Floating point type used for synthesis and filtering
+   * @param[in, out] time_histories Location where time histories should be
+   *                                stored
+   * @param[in] parameters Set of model parameters to use for calculating power
+   *                       specturm and time histories
+   * @param[in] family_index Index of family within the event ensemble
+   * @return Returns true if successful, false otherwise
+   */
+  template <typename T>
+  bool time_history_family_impl(std::vector<std::vector<T>>& time_histories,
+                                const Eigen::VectorXd& parameters,
+                                unsigned int family_index) const;
+
+  /**
+   * Matrix of spectral amplitudes, which are the square root of the power
+   * spectrum, stored by time step so that all frequencies at a time step are
+   * contiguous
+   * @tparam T Floating point type of amplitudes
+   */
+  template <typename T>
+  using AmplitudeMatrix =
+      Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+  /**
+   * Function that computes amplitudes of the power spectrum for a tile of
+   * consecutive time steps. Takes the index of the first time step, the
+   * number of time steps and the matrix whose leading rows the amplitudes
+   * are written to.
+   * @tparam T Floating point type of amplitudes
+   */
+  template <typename T>
+  using SpectrumTile =
+      std::function<void(unsigned int, unsigned int, AmplitudeMatrix<T>&)>;
+
+  /**
+   * Simulate ground motion sample realization in requested precision
+   * @tparam T Floating point type used for synthesis
+   * @param[in, out] time_history Location where time history should be stored
+   * @param[in] amplitudes Matrix containing square root of power spectrum
+   *                       over range of frequencies at specified times
+   * @param[in] event_index Index of time history within the event ensemble
+   * @param[in] antithetic Whether to shift phase angles by pi
+   * @param[in] frame_spacing Number of time steps between amplitude frames of
+   *                          interpolated synthesis, where 1 evaluates the
+   *                          exact sum
+   * @param[in] first_freq Frequency index of first column of amplitudes
+   */
+  template <typename T>
+  void simulate_time_history_impl(std::vector<T>& time_history,
+                                  const AmplitudeMatrix<T>& amplitudes,
+                                  unsigned int event_index, bool antithetic,
+                                  unsigned int frame_spacing,
+                                  unsigned int first_freq) const;
+
+  /**
+   * Find spacing of amplitude frames used for synthesizing time histories
+   * from the input amplitudes with the current synthesis method
+   * @tparam T Floating point type of amplitudes
+   * @param[in] amplitudes Matrix containing square root of power spectrum
+   *                       over range of frequencies at specified times
+   * @return Number of time steps between amplitude frames, which is 1 for
+   *         exact synthesis
+   */
+  template <typename T>
+  unsigned int frame_spacing(const AmplitudeMatrix<T>& amplitudes) const;
+
+  /**
+   * Synthesize time history by evaluating the spectral representation sum at
+   * every time step. Cosines are advanced from one time step to the next by
+   * complex rotation of a phasor for each frequency, with frequencies
+   * processed in SIMD lanes. Phasors are reset from the phase computed in
+   * double precision every 64 time steps, so the difference from direct
+   * evaluation of the cosines is below 64 times the machine epsilon of T
+   * relative to the sum of the amplitudes at each time step.
+   * @tparam T Floating point type of amplitudes and time history
+   * @param[in, out] time_history Location where time history should be stored
+   * @param[in] amplitudes Matrix containing square root of power spectrum
+   *                       over range of frequencies at specified times
+   * @param[in] phase_angle Phase angle of each frequency
+   * @param[in] first_freq Frequency index of first column of amplitudes
+   */
+  template <typename T>
+  void exact_synthesis(std::vector<T>& time_history,
+                       const AmplitudeMatrix<T>& amplitudes,
+                       const std::vector<double>& phase_angle,
+                       unsigned int first_freq) const;
+
+  /**
+   * Synthesize all time histories of a family by evaluating the spectral
+   * representation sum at every time step. Histories share the amplitudes
+   * and differ only in their phase angles, so for each tile of time steps
+   * the histories are the product of a basis of amplitudes times cosines and
+   * sines of frequency times time with the cosines and sines of the phase
+   * angles of every history, computed as a single matrix product. Amplitudes
+   * are computed for each tile just before it is synthesized, with tiles
+   * sized so that amplitudes and basis fit in L2 cache, so memory use does
+   * not depend on record length.
+   * @tparam T Floating point type of amplitudes and time histories
+   * @param[in, out] time_histories Location where time histories should be
+   *                                stored
+   * @param[in] num_times Number of time steps
+   * @param[in] num_freqs Number of frequencies
+   * @param[in] first_freq Frequency index of first column of amplitudes
+   * @param[in] spectrum_tile Function computing amplitudes for tile of time
+   *                          steps
+   * @param[in] family_index Index of family within the event ensemble
+   */
+  template <typename T>
+  void batched_synthesis(std::vector<std::vector<T>>& time_histories,
+                         unsigned int num_times, unsigned int num_freqs,
+                         unsigned int first_freq,
+                         const SpectrumTile<T>& spectrum_tile,
+                         unsigned int family_index) const;
+
+  /**
+   * Draw phase angles of time history from its random stream
+   * @param[in] num_freqs Number of frequencies
+   * @param[in] event_index Index of time history within the event ensemble
+   * @param[in] antithetic Whether to shift phase angles by pi
+   * @return Vector containing phase angle of each frequency
+   */
+  std::vector<double> phase_angles(unsigned int num_freqs,
+                                   unsigned int event_index,
+                                   bool antithetic) const;
+
+  /**
+   * Synthesize time history from amplitudes interpolated between frames.
+   * Amplitudes are interpolated linearly between frames, so the time history
+   * is the sum of the stationary time history of each frame weighted by its
+   * interpolation function, which is evaluated with a chirp-z transform.
+   * @tparam T Floating point type of power spectrum and time history
+   * @param[in, out] time_history Location where time history should be stored
+   * @param[in] amplitudes Matrix containing square root of power spectrum
+   *                       over range of frequencies at specified times
+   * @param[in] phase_angle Phase angle of each frequency
+   * @param[in] frame_spacing Number of time steps between amplitude frames
+   * @param[in] first_freq Frequency index of first column of amplitudes
+   */
+  template <typename T>
+  void interpolated_synthesis(std::vector<T>& time_history,
+                              const AmplitudeMatrix<T>& amplitudes,
+                              const std::vector<double>& phase_angle,
+                              unsigned int frame_spacing,
+                              unsigned int first_freq) const;
+
+  /**
+   * Post-process time history in requested precision
+   * @tparam T Floating point type of time history and filter
+   * @param[in, out] time_history Time history to post-process. Post-processed
+   *                              results are also stored here.
+   * @param[in] filter_kernel Prepared impulse response of Butterworth filter
+   * @return Returns true if successful, false otherwise
+   */
+  template <typename T>
+  bool post_process_impl(
+      std::vector<T>& time_history,
+      const numeric_utils::BasicConvolutionKernel<T>& filter_kernel) const;
+
+  /**
+   * Rotate acceleration in requested precision
+   * @tparam T Floating point type of accelerations
+   * @param[in] acceleration Acceleration to rotate
+   * @param[in, out] x_accels Vector to store x-component of acceleration to
+   * @param[in, out] y_accels Vector to story y-component of acceleration to
+   * @param[in] g_units Indicates that time histories should be returned in
+   *                    units of g
+   */
+  template <typename T>
+  void rotate_acceleration_impl(const std::vector<T>& acceleration,
+                                std::vector<T>& x_accels,
+                                std::vector<T>& y_accels, bool g_units) const;
+
   double moment_magnitude_; /**< Moment magnitude for scenario */
   double rupture_dist_; /**< Closest-to-site rupture distance in kilometers */
   double vs30_; /**< Soil shear wave velocity averaged over top 30 meters in
                    meters per second */
   double orientation_; /**< Counter-clockwise angle away from global x-axis */
-  double time_step_; /**< Temporal discretization. Set to 0.01 seconds */
-  double freq_step_; /**< Frequency discretization. Set to 0.2 Hz */
-  double cutoff_freq_; /**< Cutoff frequency */
+  double time_step_; /**< Temporal discretization in seconds */
+  double freq_step_; /**< Frequency discretization in radians per second */
+  double cutoff_freq_; /**< Cutoff frequency in radians per second */
   unsigned int num_spectra_; /**< Number of evolutionary power spectra that
                                 should be generated */
   unsigned int num_sims_; /**< Number of simulated ground motion time histories
                              that should be generated per evolutionary power
                              spectrum */
   int seed_value_; /**< Integer to seed random distributions with */
+  std::uint64_t stream_seed_; /**< Seed for random streams of time histories */
   Eigen::VectorXd means_; /**< Mean values of model parameters */
   Eigen::MatrixXd covariance_; /**< Covariance matrix for model parameters */
   std::vector<std::shared_ptr<stochastic::Distribution>>
@@ -269,8 +760,16 @@ class VlachosEtAl : public StochasticModel {
   Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>
       physical_parameters_; /**< Normal parameters transformed to
                                physical space */
+  Eigen::VectorXd likelihood_weights_; /**< Likelihood ratio weight of model
+                                          parameters of each spectrum */
   std::shared_ptr<numeric_utils::RandomGenerator>
       sample_generator_; /**< Multivariate normal random number generator */
+  SynthesisMethod synthesis_ =
+      SynthesisMethod::Exact; /**< Method used to synthesize time histories */
+  double synthesis_tolerance_ =
+      1.0E-3; /**< Relative error tolerance of interpolated synthesis */
+  double energy_threshold_ =
+      0.0; /**< Relative energy threshold for truncating frequency range */
 };
 }  // namespace stochastic
 
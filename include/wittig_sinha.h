@@ -1,6 +1,8 @@
 #ifndef _WITTIG_SINHA_H_
 #define _WITTIG_SINHA_H_
 
+#include <complex>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <Eigen/Dense>
@@ -127,6 +129,20 @@ class WittigSinha : public StochasticModel {
   bool generate(const std::string& event_name,
                 const std::string& output_location, bool units = false) override;
 
+  /**
+   * Adaptive ensemble size is not supported, since each call to generate
+   * simulates a single event
+   * @param[in] statistic Target statistics of each time series of an event
+   * @param[in] tolerance Largest allowed half-width of confidence intervals
+   *                      relative to magnitude of mean values
+   * @param[in] min_samples Number of samples generated before checking
+   *                        convergence
+   * @param[in] confidence Confidence level of intervals
+   */
+  void set_adaptive_ensemble(EventStatistic statistic, double tolerance,
+                             unsigned int min_samples = 10,
+                             double confidence = 0.95) override;
+
   /**
    * Calculate the cross-spectral density matrix 
    * @param[in] frequency Frequency at which to calculate cross-spectral density
@@ -137,9 +153,20 @@ class WittigSinha : public StochasticModel {
   /**
    * Generate matrix of complex random number from standard normal distribution scaled
    * by lower Cholesky decomposition of the cross-spectral density matrix
+   * @param[in] location_index Index of plan location the random numbers are
+   *                           generated for. White noise at each height is
+   *                           drawn from the random stream keyed on this
+   *                           index and the height. Defaults to 0.
+   * @param[in] antithetic Whether to negate the white noise, which gives the
+   *                       antithetic counterpart of the random numbers for
+   *                       the same location index. Velocity fluctuations are
+   *                       negated, so even statistics such as their power
+   *                       spectral density are the same for both. Defaults
+   *                       to false.
    * @return A matrix containing complex random numbers
    */
-  Eigen::MatrixXcd complex_random_numbers() const;
+  Eigen::MatrixXcd complex_random_numbers(unsigned int location_index = 0,
+                                          bool antithetic = false) const;
 
   /**
    * Generate velocity time histories at vertical location specified
@@ -157,12 +184,73 @@ class WittigSinha : public StochasticModel {
                                         unsigned int column_index,
                                         bool units) const;
 
+  /**
+   * Generate velocity time histories at all vertical locations using a single
+   * batched inverse Fast Fourier Transform
+   * @param[in] random_numbers Matrix of complex random numbers to use for
+   *                           velocity time history generation, with one
+   *                           column per vertical location
+   * @param[in] units Indicates that time histories should be returned in
+   *                  units of ft/s. Otherwise time histories are returned
+   *                  in units of m/s
+   * @return Matrix with velocity time history for each vertical location
+   *         stored in corresponding column
+   */
+  Eigen::MatrixXd gen_location_hists(const Eigen::MatrixXcd& random_numbers,
+                                     bool units) const;
+
+  /**
+   * Generate single precision velocity time histories at all vertical
+   * locations using a single batched inverse Fast Fourier Transform
+   * @param[in] random_numbers Matrix of complex random numbers to use for
+   *                           velocity time history generation, with one
+   *                           column per vertical location
+   * @param[in] units Indicates that time histories should be returned in
+   *                  units of ft/s. Otherwise time histories are returned
+   *                  in units of m/s
+   * @return Matrix with velocity time history for each vertical location
+   *         stored in corresponding column
+   */
+  Eigen::MatrixXf gen_location_hists(const Eigen::MatrixXcf& random_numbers,
+                                     bool units) const;
+
  private:
+  /**
+   * Generate wind velocity time histories in requested precision and store
+   * outputs as JSON object
+   * @tparam T Floating point type used for synthesis and output
+   * @param[in] units Indicates that time histories should be returned in
+   *                  units of ft/s
+   * @return JsonObject containing loading time histories
+   */
+  template <typename T>
+  utilities::JsonObject generate_event(bool units);
+
+  /**
+   * Generate velocity time histories at all vertical locations in requested
+   * precision
+   * @tparam T Floating point type used for synthesis
+   * @param[in] random_numbers Matrix of complex random numbers with one column
+   *                           per vertical location
+   * @param[in] units Indicates that time histories should be returned in
+   *                  units of ft/s
+   * @return Matrix with velocity time history for each vertical location
+   *         stored in corresponding column
+   */
+  template <typename T>
+  Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> location_hists(
+      const Eigen::Matrix<std::complex<T>, Eigen::Dynamic, Eigen::Dynamic>&
+          random_numbers,
+      bool units) const;
+
   std::string exposure_category_; /**< Exposure category for building based on ASCE-7 */
   double gust_speed_; /**< Gust speed for wind */
   double bldg_height_; /**< Height of building */
   unsigned int num_floors_; /**< Number of floors */
   int seed_value_; /**< Integer to seed random distributions with */
+  std::uint64_t stream_seed_; /**< Seed for random streams of white noise */
+  bool pair_pending_ = false; /**< Whether next event completes antithetic
+                                 pair with previous event */
   std::vector<double> heights_; /**< Locations along building height at which
                                    velocities are generated */
   std::vector<double> local_x_; /**< Locations along local x-axis at which to
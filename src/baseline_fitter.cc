@@ -0,0 +1,184 @@
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <Eigen/Dense>
+#include "baseline_fitter.h"
+
+namespace numeric_utils {
+BaselineFitter::BaselineFitter(std::size_t num_points, double time_step,
+                               unsigned int degree)
+    : num_points_{num_points}, time_step_{time_step}, degree_{degree} {
+  if (degree_ < 2) {
+    throw std::runtime_error(
+        "\nERROR: in numeric_utils::BaselineFitter: Polynomial degree must be "
+        "at least 2\n");
+  }
+
+  unsigned int num_terms = degree_ - 1;
+  if (num_points_ < num_terms || time_step_ <= 0.0) {
+    throw std::runtime_error(
+        "\nERROR: in numeric_utils::BaselineFitter: Records must contain at "
+        "least as many samples as fitted terms and have a positive time "
+        "step\n");
+  }
+
+  // Scale time to unit interval so that basis columns have similar magnitude
+  time_scale_ =
+      num_points_ > 1 ? static_cast<double>(num_points_ - 1) * time_step_
+                      : time_step_;
+
+  // Scaled basis with columns ordered in descending power from degree to 2
+  Eigen::ArrayXd scaled_times =
+      Eigen::ArrayXd::LinSpaced(num_points_, 0.0,
+                                static_cast<double>(num_points_ - 1)) *
+      (time_step_ / time_scale_);
+  Eigen::MatrixXd basis(num_points_, num_terms);
+  Eigen::ArrayXd powers = scaled_times.square();
+  for (unsigned int i = 0; i < num_terms; ++i) {
+    basis.col(num_terms - 1 - i) = powers.matrix();
+    powers *= scaled_times;
+  }
+
+  // Orthonormal columns of Q are a discrete orthogonal polynomial basis on the
+  // time grid
+  Eigen::HouseholderQR<Eigen::MatrixXd> qr(basis);
+  Eigen::MatrixXd orthonormal_basis =
+      qr.householderQ() * Eigen::MatrixXd::Identity(num_points_, num_terms);
+  projection_ = orthonormal_basis.transpose();
+  triangular_ = qr.matrixQR()
+                    .topRows(num_terms)
+                    .triangularView<Eigen::Upper>();
+}
+
+Eigen::MatrixXd BaselineFitter::fit(const Eigen::MatrixXd& data) const {
+  if (static_cast<std::size_t>(data.rows()) != num_points_) {
+    throw std::runtime_error(
+        "\nERROR: in numeric_utils::BaselineFitter::fit: Records must contain "
+        "num_points() samples\n");
+  }
+
+  unsigned int num_terms = degree_ - 1;
+  Eigen::MatrixXd scaled_coefficients =
+      triangular_.triangularView<Eigen::Upper>().solve(projection_ * data);
+
+  // Undo time scaling and append zero linear and constant terms
+  Eigen::MatrixXd coefficients =
+      Eigen::MatrixXd::Zero(degree_ + 1, data.cols());
+  for (unsigned int i = 0; i < num_terms; ++i) {
+    coefficients.row(i) = scaled_coefficients.row(i) /
+                          std::pow(time_scale_, static_cast<int>(degree_ - i));
+  }
+
+  return coefficients;
+}
+
+Eigen::MatrixXd BaselineFitter::evaluate(const Eigen::MatrixXd& data,
+                                         unsigned int derivative) const {
+  if (static_cast<std::size_t>(data.rows()) != num_points_) {
+    throw std::runtime_error(
+        "\nERROR: in numeric_utils::BaselineFitter::evaluate: Records must "
+        "contain num_points() samples\n");
+  }
+
+  // Projection onto orthonormal basis gives fitted values directly
+  Eigen::MatrixXd basis_weights = projection_ * data;
+  if (derivative == 0) {
+    return projection_.transpose() * basis_weights;
+  }
+
+  unsigned int num_terms = degree_ - 1;
+  Eigen::MatrixXd scaled_coefficients =
+      triangular_.triangularView<Eigen::Upper>().solve(basis_weights);
+
+  // Derivative of scaled monomial s^p with respect to time is
+  // p! / (p - k)! * s^(p - k) / T^k
+  Eigen::ArrayXd scaled_times =
+      Eigen::ArrayXd::LinSpaced(num_points_, 0.0,
+                                static_cast<double>(num_points_ - 1)) *
+      (time_step_ / time_scale_);
+  Eigen::MatrixXd derivative_basis =
+      Eigen::MatrixXd::Zero(num_points_, num_terms);
+  for (unsigned int i = 0; i < num_terms; ++i) {
+    unsigned int power = degree_ - i;
+    if (derivative > power) {
+      continue;
+    }
+    double scale = 1.0;
+    for (unsigned int k = 0; k < derivative; ++k) {
+      scale *= static_cast<double>(power - k);
+    }
+    derivative_basis.col(i) =
+        (scaled_times.pow(static_cast<double>(power - derivative)) * scale /
+         std::pow(time_scale_, static_cast<int>(derivative)))
+            .matrix();
+  }
+
+  return derivative_basis * scaled_coefficients;
+}
+
+std::shared_ptr<const BaselineFitter> BaselineFitterCache::fitter(
+    std::size_t num_points, double time_step, unsigned int degree) {
+  FitterKey key{num_points, time_step, degree};
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto cached = lookup_.find(key);
+    if (cached != lookup_.end()) {
+      // Move fitter to front of list to mark as most recently used
+      fitters_.splice(fitters_.begin(), fitters_, cached->second);
+      return cached->second->second;
+    }
+  }
+
+  // Factorize outside of lock so threads requesting other fitters are not
+  // blocked
+  std::shared_ptr<const BaselineFitter> new_fitter =
+      std::make_shared<const BaselineFitter>(num_points, time_step, degree);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  // Another thread may have created the same fitter in the meantime
+  auto cached = lookup_.find(key);
+  if (cached != lookup_.end()) {
+    fitters_.splice(fitters_.begin(), fitters_, cached->second);
+    return cached->second->second;
+  }
+
+  if (capacity_ > 0) {
+    fitters_.emplace_front(key, new_fitter);
+    lookup_[key] = fitters_.begin();
+    trim();
+  }
+
+  return new_fitter;
+}
+
+void BaselineFitterCache::set_capacity(std::size_t capacity) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  capacity_ = capacity;
+  trim();
+}
+
+std::size_t BaselineFitterCache::capacity() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return capacity_;
+}
+
+std::size_t BaselineFitterCache::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return fitters_.size();
+}
+
+void BaselineFitterCache::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  lookup_.clear();
+  fitters_.clear();
+}
+
+void BaselineFitterCache::trim() {
+  while (fitters_.size() > capacity_) {
+    lookup_.erase(fitters_.back().first);
+    fitters_.pop_back();
+  }
+}
+}  // namespace numeric_utils
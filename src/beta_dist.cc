@@ -30,3 +30,11 @@ std::vector<double> stochastic::BetaDistribution::inv_cumulative_dist_func(
 
   return evaluations;
 }
+
+double stochastic::BetaDistribution::transform_exact(double value) const {
+  return std_normal_quantile(distribution_, value);
+}
+
+double stochastic::BetaDistribution::density(double location) const {
+  return pdf(distribution_, location);
+}
@@ -0,0 +1,68 @@
+#include <algorithm>
+#include <complex>
+#include <stdexcept>
+#include <vector>
+#include "chirp_z_transform.h"
+#include "fft_plan.h"
+
+namespace numeric_utils {
+ChirpZTransform::ChirpZTransform(std::size_t num_inputs,
+                                 std::size_t num_outputs, double angle_step)
+    : num_inputs_{num_inputs}, num_outputs_{num_outputs} {
+  if (num_inputs == 0 || num_outputs == 0) {
+    throw std::runtime_error(
+        "\nERROR: in numeric_utils::ChirpZTransform: Number of inputs and "
+        "outputs must both be positive\n");
+  }
+
+  // Using j * m = (j^2 + m^2 - (m - j)^2) / 2 turns the sum into a linear
+  // convolution with a chirp, which is evaluated with circular convolution
+  fft_length_ = next_fast_fft_length(num_inputs_ + num_outputs_ - 1);
+
+  forward_plan_ = FftPlanCache::instance()->plan(
+      fft_length_, FftDirection::Forward, FftDomain::Complex);
+  backward_plan_ = FftPlanCache::instance()->plan(
+      fft_length_, FftDirection::Backward, FftDomain::Complex);
+
+  // Squared indices are formed in integer arithmetic so only the final
+  // product with the angle step is rounded
+  std::size_t num_chirp = std::max(num_inputs_, num_outputs_);
+  chirp_.resize(num_chirp);
+  for (std::size_t k = 0; k < num_chirp; ++k) {
+    chirp_[k] = std::polar(
+        1.0, 0.5 * angle_step * static_cast<double>(k * k));
+  }
+
+  // Conjugate chirp is needed at offsets from -(num_inputs - 1) to
+  // num_outputs - 1, with negative offsets wrapped to end of buffer
+  std::vector<std::complex<double>> wrapped_chirp(fft_length_, 0.0);
+  for (std::size_t k = 0; k < num_outputs_; ++k) {
+    wrapped_chirp[k] = std::conj(chirp_[k]);
+  }
+  for (std::size_t k = 1; k < num_inputs_; ++k) {
+    wrapped_chirp[fft_length_ - k] = std::conj(chirp_[k]);
+  }
+
+  chirp_spectrum_.resize(fft_length_);
+  forward_plan_->execute(wrapped_chirp.data(), chirp_spectrum_.data());
+}
+
+void ChirpZTransform::execute(const std::complex<double>* input,
+                              std::complex<double>* output) const {
+  std::vector<std::complex<double>> buffer(fft_length_, 0.0);
+  for (std::size_t j = 0; j < num_inputs_; ++j) {
+    buffer[j] = input[j] * chirp_[j];
+  }
+
+  std::vector<std::complex<double>> spectrum(fft_length_);
+  forward_plan_->execute(buffer.data(), spectrum.data());
+  for (std::size_t k = 0; k < fft_length_; ++k) {
+    spectrum[k] *= chirp_spectrum_[k];
+  }
+  backward_plan_->execute(spectrum.data(), buffer.data());
+
+  for (std::size_t m = 0; m < num_outputs_; ++m) {
+    output[m] = buffer[m] * chirp_[m];
+  }
+}
+}  // namespace numeric_utils
@@ -8,6 +8,7 @@
 #include "filter.h"
 #include "function_dispatcher.h"
 #include "inv_gauss_dist.h"
+#include "lhs_normal_multivar.h"
 #include "lognormal_dist.h"
 #include "numeric_utils.h"
 #include "normal_dist.h"
@@ -27,6 +28,13 @@ void config::initialize() {
   static Register<numeric_utils::RandomGenerator, numeric_utils::NormalMultiVar,
                   int>
       normal_multivar("MultivariateNormal");
+  // Register Latin hypercube multivariate normal random number generator
+  static Register<numeric_utils::RandomGenerator,
+                  numeric_utils::LhsNormalMultiVar>
+      lhs_normal_multivar_default("MultivariateNormalLHS");
+  static Register<numeric_utils::RandomGenerator,
+                  numeric_utils::LhsNormalMultiVar, int>
+      lhs_normal_multivar("MultivariateNormalLHS");
 
   // DISTRIBUTION TYPES
   // Register normal distribution
@@ -59,29 +67,66 @@ void config::initialize() {
   static Register<stochastic::StochasticModel, stochastic::VlachosEtAl, double,
                   double, double, double, unsigned int, unsigned int>
       vlachos_et_al("VlachosSiteSpecificEQ");
+  static Register<stochastic::StochasticModel, stochastic::VlachosEtAl, double,
+                  double, double, double, unsigned int, unsigned int,
+                  std::string>
+      vlachos_et_al_unseeded_sampler("VlachosSiteSpecificEQ");
   static Register<stochastic::StochasticModel, stochastic::VlachosEtAl, double,
                   double, double, double, unsigned int, unsigned int, int>
       vlachos_et_al_seed("VlachosSiteSpecificEQ");
+  static Register<stochastic::StochasticModel, stochastic::VlachosEtAl, double,
+                  double, double, double, unsigned int, unsigned int, int,
+                  std::string>
+      vlachos_et_al_sampler("VlachosSiteSpecificEQ");
+  static Register<stochastic::StochasticModel, stochastic::VlachosEtAl, double,
+                  double, double, double, unsigned int, unsigned int, int,
+                  double, double, double, double>
+      vlachos_et_al_discretization("VlachosSiteSpecificEQ");
+  static Register<stochastic::StochasticModel, stochastic::VlachosEtAl, double,
+                  double, double, double, unsigned int, unsigned int, int,
+                  double, double, double, double, std::string>
+      vlachos_et_al_discretization_sampler("VlachosSiteSpecificEQ");
   static Register<stochastic::StochasticModel, stochastic::DabaghiDerKiureghian,
                   stochastic::FaultType, stochastic::SimulationType, double,
                   double, double, double, double, double, unsigned int,
                   unsigned int, bool>
       dabaghi_der_kiureghian("DabaghiDerKiureghianNFGM");
+  static Register<stochastic::StochasticModel, stochastic::DabaghiDerKiureghian,
+                  stochastic::FaultType, stochastic::SimulationType, double,
+                  double, double, double, double, double, unsigned int,
+                  unsigned int, bool, std::string>
+      dabaghi_der_kiureghian_unseeded_sampler("DabaghiDerKiureghianNFGM");
   static Register<stochastic::StochasticModel, stochastic::DabaghiDerKiureghian,
                   stochastic::FaultType, stochastic::SimulationType, double,
                   double, double, double, double, double, unsigned int,
                   unsigned int, bool, int>
       dabaghi_der_kiureghian_seed("DabaghiDerKiureghianNFGM");
+  static Register<stochastic::StochasticModel, stochastic::DabaghiDerKiureghian,
+                  stochastic::FaultType, stochastic::SimulationType, double,
+                  double, double, double, double, double, unsigned int,
+                  unsigned int, bool, int, std::string>
+      dabaghi_der_kiureghian_sampler("DabaghiDerKiureghianNFGM");
   static Register<stochastic::StochasticModel, stochastic::LiningDiaozemin,
                   stochastic::FaultType, stochastic::SimulationType, double,
                   double, double, double, double, unsigned int,
                   unsigned int, bool, int>
       li_diao_v_h("LiningDiaozemin_VH");
+  static Register<stochastic::StochasticModel, stochastic::LiningDiaozemin,
+                  stochastic::FaultType, stochastic::SimulationType, double,
+                  double, double, double, double, unsigned int,
+                  unsigned int, bool, int, std::string>
+      li_diao_v_h_sampler("LiningDiaozemin_VH");
   static Register<stochastic::StochasticModel, stochastic::LiningDiaozemin_MP,
                   stochastic::FaultType, stochastic::SimulationType, double,
                   double, double, double, double, unsigned int,
                   unsigned int, bool, int, int, stochastic::CohType>
       li_diao_mp("LiningDiaozemin_MP");
+  static Register<stochastic::StochasticModel, stochastic::LiningDiaozemin_MP,
+                  stochastic::FaultType, stochastic::SimulationType, double,
+                  double, double, double, double, unsigned int,
+                  unsigned int, bool, int, int, stochastic::CohType,
+                  std::string>
+      li_diao_mp_sampler("LiningDiaozemin_MP");
 
   // Wind
   static Register<stochastic::StochasticModel, stochastic::WittigSinha,
@@ -0,0 +1,84 @@
+#include <algorithm>
+#include <complex>
+#include <stdexcept>
+#include <vector>
+#include "convolution_kernel.h"
+#include "fft_plan.h"
+
+namespace numeric_utils {
+template <typename T>
+BasicConvolutionKernel<T>::BasicConvolutionKernel(const std::vector<T>& kernel,
+                                                  std::size_t block_size)
+    : kernel_size_{kernel.size()} {
+  if (kernel.empty()) {
+    throw std::runtime_error(
+        "\nERROR: in numeric_utils::ConvolutionKernel: Kernel must contain at "
+        "least one value\n");
+  }
+
+  // When block size is not specified, use transforms several times longer
+  // than kernel so that overlap between blocks is a small fraction of work
+  if (block_size == 0) {
+    fft_length_ = next_fast_fft_length(
+        std::max<std::size_t>(8 * kernel_size_, 1024));
+  } else {
+    fft_length_ = next_fast_fft_length(block_size + kernel_size_ - 1);
+  }
+  block_size_ = fft_length_ - kernel_size_ + 1;
+
+  forward_plan_ = FftPlanCache::instance()->plan(
+      fft_length_, FftDirection::Forward, FftDomain::Real,
+      FftPrecisionOf<T>::value);
+  backward_plan_ = FftPlanCache::instance()->plan(
+      fft_length_, FftDirection::Backward, FftDomain::Real,
+      FftPrecisionOf<T>::value);
+
+  // Transform zero-padded kernel once
+  std::vector<T> padded_kernel(fft_length_, T(0));
+  std::copy(kernel.begin(), kernel.end(), padded_kernel.begin());
+  kernel_spectrum_.resize(fft_length_ / 2 + 1);
+  forward_plan_->execute(padded_kernel.data(), kernel_spectrum_.data());
+}
+
+template <typename T>
+bool BasicConvolutionKernel<T>::convolve(const std::vector<T>& input,
+                                         std::vector<T>& response) const {
+  if (input.empty()) {
+    throw std::runtime_error(
+        "\nERROR: in numeric_utils::ConvolutionKernel::convolve: Input must "
+        "contain at least one value\n");
+  }
+
+  response.assign(input.size() + kernel_size_ - 1, T(0));
+
+  std::vector<T> block(fft_length_);
+  std::vector<std::complex<T>> block_spectrum(kernel_spectrum_.size());
+
+  // Overlap-add: convolve each block of input separately and accumulate the
+  // overlapping tails into the response
+  for (std::size_t start = 0; start < input.size(); start += block_size_) {
+    std::size_t num_samples = std::min(block_size_, input.size() - start);
+
+    std::fill(std::copy(input.begin() + start,
+                        input.begin() + start + num_samples, block.begin()),
+              block.end(), T(0));
+
+    forward_plan_->execute(block.data(), block_spectrum.data());
+    for (std::size_t i = 0; i < block_spectrum.size(); ++i) {
+      block_spectrum[i] *= kernel_spectrum_[i];
+    }
+    backward_plan_->execute(block_spectrum.data(), block.data());
+
+    std::size_t num_outputs = num_samples + kernel_size_ - 1;
+    for (std::size_t i = 0; i < num_outputs; ++i) {
+      response[start + i] += block[i];
+    }
+  }
+
+  return true;
+}
+
+// Explicit instantiations for supported precisions
+template class BasicConvolutionKernel<float>;
+template class BasicConvolutionKernel<double>;
+}  // namespace numeric_utils
@@ -0,0 +1,25 @@
+#include <memory>
+#include "distribution.h"
+#include "quantile_table.h"
+
+void stochastic::Distribution::transform_from_std_normal(
+    ValuesRef values) const {
+  if (quantile_table_) {
+    quantile_table_->transform(values);
+  } else {
+    values = values.unaryExpr(
+        [this](double value) { return transform_exact(value); });
+  }
+}
+
+bool stochastic::Distribution::build_quantile_table(double tolerance) {
+  quantile_table_ = std::make_shared<QuantileTable>(
+      [this](double value) { return transform_exact(value); },
+      [this](double location) { return density(location); }, tolerance);
+
+  if (!quantile_table_->valid()) {
+    quantile_table_.reset();
+  }
+
+  return quantile_table_ != nullptr;
+}
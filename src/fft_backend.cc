@@ -0,0 +1,67 @@
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "fft_backend.h"
+#include "native_fft.h"
+#ifdef SMELT_WITH_MKL
+#include "mkl_fft.h"
+#endif
+
+// Backend used when none is requested at run time
+#ifndef SMELT_DEFAULT_FFT_BACKEND
+#ifdef SMELT_WITH_MKL
+#define SMELT_DEFAULT_FFT_BACKEND "MKL"
+#else
+#define SMELT_DEFAULT_FFT_BACKEND "Native"
+#endif
+#endif
+
+namespace numeric_utils {
+namespace {
+std::shared_ptr<const FftBackend> create_fft_backend(const std::string& name) {
+#ifdef SMELT_WITH_MKL
+  if (name == "MKL") {
+    return std::make_shared<const MklFftBackend>();
+  }
+#endif
+  if (name == "Native") {
+    return std::make_shared<const NativeFftBackend>();
+  }
+
+  throw std::runtime_error(
+      "\nERROR: in numeric_utils::set_fft_backend: Requested FFT backend " +
+      name + " is not available\n");
+}
+
+std::mutex backend_mutex;
+std::shared_ptr<const FftBackend> selected_backend;
+}  // namespace
+
+std::vector<std::string> fft_backends() {
+  std::vector<std::string> backends;
+#ifdef SMELT_WITH_MKL
+  backends.push_back("MKL");
+#endif
+  backends.push_back("Native");
+  return backends;
+}
+
+void set_fft_backend(const std::string& name) {
+  auto backend = create_fft_backend(name);
+  std::lock_guard<std::mutex> lock(backend_mutex);
+  selected_backend = backend;
+}
+
+std::shared_ptr<const FftBackend> fft_backend() {
+  std::lock_guard<std::mutex> lock(backend_mutex);
+  if (!selected_backend) {
+    const char* requested = std::getenv("SMELT_FFT_BACKEND");
+    selected_backend = create_fft_backend(
+        requested && *requested ? requested : SMELT_DEFAULT_FFT_BACKEND);
+  }
+  return selected_backend;
+}
+}  // namespace numeric_utils
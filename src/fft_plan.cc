@@ -0,0 +1,242 @@
+#include <complex>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include "fft_plan.h"
+
+namespace numeric_utils {
+std::size_t next_fast_fft_length(std::size_t min_length) {
+  if (min_length <= 1) {
+    return 1;
+  }
+
+  std::size_t length = min_length;
+  while (true) {
+    std::size_t remainder = length;
+    for (std::size_t factor : {2, 3, 5}) {
+      while (remainder % factor == 0) {
+        remainder /= factor;
+      }
+    }
+    if (remainder == 1) {
+      return length;
+    }
+    ++length;
+  }
+}
+
+FftPlan::FftPlan(std::size_t length, FftDirection direction, FftDomain domain,
+                 FftPrecision precision)
+    : FftPlan(length, direction, domain, FftLayout(), precision) {}
+
+FftPlan::FftPlan(std::size_t length, FftDirection direction, FftDomain domain,
+                 const FftLayout& layout, FftPrecision precision)
+    : length_{length},
+      direction_{direction},
+      domain_{domain},
+      precision_{precision},
+      layout_{layout} {
+  if (length_ == 0) {
+    throw std::runtime_error(
+        "\nERROR: in numeric_utils::FftPlan: Transform length must be "
+        "positive\n");
+  }
+
+  if (layout_.num_transforms == 0 || layout_.input_stride == 0 ||
+      layout_.output_stride == 0 ||
+      (layout_.num_transforms > 1 &&
+       (layout_.input_distance == 0 || layout_.output_distance == 0))) {
+    throw std::runtime_error(
+        "\nERROR: in numeric_utils::FftPlan: Invalid layout, strides and "
+        "distances between multiple transforms must be positive\n");
+  }
+
+  auto backend = fft_backend();
+  backend_ = backend->name();
+  backend_plan_ =
+      backend->create_plan(length_, direction_, domain_, layout_, precision_);
+}
+
+FftPlan::~FftPlan() {}
+
+void FftPlan::execute(const std::complex<double>* input,
+                      std::complex<double>* output) const {
+  compute(FftDomain::Complex, FftPrecision::Double, input, output);
+}
+
+void FftPlan::execute(const std::complex<double>* input, double* output) const {
+  if (direction_ != FftDirection::Backward) {
+    throw std::runtime_error(
+        "\nERROR: in numeric_utils::FftPlan::execute: Complex to real "
+        "transform requires backward plan\n");
+  }
+  compute(FftDomain::Real, FftPrecision::Double, input, output);
+}
+
+void FftPlan::execute(const double* input, std::complex<double>* output) const {
+  if (direction_ != FftDirection::Forward) {
+    throw std::runtime_error(
+        "\nERROR: in numeric_utils::FftPlan::execute: Real to complex "
+        "transform requires forward plan\n");
+  }
+  compute(FftDomain::Real, FftPrecision::Double, input, output);
+}
+
+void FftPlan::execute(const std::complex<float>* input,
+                      std::complex<float>* output) const {
+  compute(FftDomain::Complex, FftPrecision::Single, input, output);
+}
+
+void FftPlan::execute(const std::complex<float>* input, float* output) const {
+  if (direction_ != FftDirection::Backward) {
+    throw std::runtime_error(
+        "\nERROR: in numeric_utils::FftPlan::execute: Complex to real "
+        "transform requires backward plan\n");
+  }
+  compute(FftDomain::Real, FftPrecision::Single, input, output);
+}
+
+void FftPlan::execute(const float* input, std::complex<float>* output) const {
+  if (direction_ != FftDirection::Forward) {
+    throw std::runtime_error(
+        "\nERROR: in numeric_utils::FftPlan::execute: Real to complex "
+        "transform requires forward plan\n");
+  }
+  compute(FftDomain::Real, FftPrecision::Single, input, output);
+}
+
+void FftPlan::execute(std::complex<double>* data) const {
+  compute(domain_ == FftDomain::Real && direction_ == FftDirection::Backward
+              ? FftDomain::Real
+              : FftDomain::Complex,
+          FftPrecision::Double, data, nullptr);
+}
+
+void FftPlan::execute(double* data) const {
+  if (direction_ != FftDirection::Forward) {
+    throw std::runtime_error(
+        "\nERROR: in numeric_utils::FftPlan::execute: Real to complex "
+        "transform requires forward plan\n");
+  }
+  compute(FftDomain::Real, FftPrecision::Double, data, nullptr);
+}
+
+void FftPlan::execute(std::complex<float>* data) const {
+  compute(domain_ == FftDomain::Real && direction_ == FftDirection::Backward
+              ? FftDomain::Real
+              : FftDomain::Complex,
+          FftPrecision::Single, data, nullptr);
+}
+
+void FftPlan::execute(float* data) const {
+  if (direction_ != FftDirection::Forward) {
+    throw std::runtime_error(
+        "\nERROR: in numeric_utils::FftPlan::execute: Real to complex "
+        "transform requires forward plan\n");
+  }
+  compute(FftDomain::Real, FftPrecision::Single, data, nullptr);
+}
+
+void FftPlan::compute(FftDomain domain, FftPrecision precision,
+                      const void* input, void* output) const {
+  if (domain != domain_ || precision != precision_) {
+    throw std::runtime_error(
+        "\nERROR: in numeric_utils::FftPlan::execute: Input and output types "
+        "do not match plan domain and precision\n");
+  }
+
+  if ((output == nullptr) != layout_.in_place) {
+    throw std::runtime_error(
+        "\nERROR: in numeric_utils::FftPlan::execute: Number of buffers does "
+        "not match plan placement\n");
+  }
+
+  backend_plan_->compute(input, output);
+}
+
+std::shared_ptr<const FftPlan> FftPlanCache::plan(std::size_t length,
+                                                  FftDirection direction,
+                                                  FftDomain domain,
+                                                  FftPrecision precision) {
+  return plan(length, direction, domain, FftLayout(), precision);
+}
+
+std::shared_ptr<const FftPlan> FftPlanCache::plan(std::size_t length,
+                                                  FftDirection direction,
+                                                  FftDomain domain,
+                                                  const FftLayout& layout,
+                                                  FftPrecision precision) {
+  // Distances are ignored for single transforms, so normalize them to avoid
+  // caching duplicate plans
+  FftLayout plan_layout = layout;
+  if (plan_layout.num_transforms == 1) {
+    plan_layout.input_distance = 0;
+    plan_layout.output_distance = 0;
+  }
+  PlanKey key{fft_backend()->name(), length, direction, domain, precision,
+              plan_layout.as_tuple()};
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto cached = lookup_.find(key);
+    if (cached != lookup_.end()) {
+      // Move plan to front of list to mark as most recently used
+      plans_.splice(plans_.begin(), plans_, cached->second);
+      return cached->second->second;
+    }
+  }
+
+  // Commit outside of lock so threads requesting other plans are not blocked
+  std::shared_ptr<const FftPlan> new_plan =
+      std::make_shared<const FftPlan>(length, direction, domain, plan_layout,
+                                      precision);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  // Backend may have been changed while plan was being committed
+  std::get<0>(key) = new_plan->backend();
+  // Another thread may have created the same plan in the meantime
+  auto cached = lookup_.find(key);
+  if (cached != lookup_.end()) {
+    plans_.splice(plans_.begin(), plans_, cached->second);
+    return cached->second->second;
+  }
+
+  if (capacity_ > 0) {
+    plans_.emplace_front(key, new_plan);
+    lookup_[key] = plans_.begin();
+    trim();
+  }
+
+  return new_plan;
+}
+
+void FftPlanCache::set_capacity(std::size_t capacity) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  capacity_ = capacity;
+  trim();
+}
+
+std::size_t FftPlanCache::capacity() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return capacity_;
+}
+
+std::size_t FftPlanCache::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return plans_.size();
+}
+
+void FftPlanCache::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  lookup_.clear();
+  plans_.clear();
+}
+
+void FftPlanCache::trim() {
+  while (plans_.size() > capacity_) {
+    lookup_.erase(plans_.back().first);
+    plans_.pop_back();
+  }
+}
+}  // namespace numeric_utils
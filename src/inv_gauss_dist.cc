@@ -33,3 +33,13 @@ std::vector<double>
 
   return evaluations;
 }
+
+double stochastic::InverseGaussianDistribution::transform_exact(
+    double value) const {
+  return std_normal_quantile(distribution_, value);
+}
+
+double stochastic::InverseGaussianDistribution::density(
+    double location) const {
+  return pdf(distribution_, location);
+}
@@ -0,0 +1,97 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <vector>
+#include <boost/math/distributions/normal.hpp>
+// Eigen dense matrices
+#include <Eigen/Dense>
+
+#include "lhs_normal_multivar.h"
+
+namespace numeric_utils {
+
+// Largest Latin hypercube drawn at once when drawing truncated samples
+const double kMaxLatinHypercubeBlock = 65536.0;
+
+LhsNormalMultiVar::LhsNormalMultiVar()
+  : NormalMultiVar()
+{
+}
+
+LhsNormalMultiVar::LhsNormalMultiVar(int seed)
+  : NormalMultiVar(seed)
+{
+}
+
+void LhsNormalMultiVar::fill_unit_normals(Eigen::MatrixXd& unit_normals) {
+  const Eigen::Index cases = unit_normals.cols();
+  const boost::math::normal_distribution<double> standard_normal;
+  std::vector<Eigen::Index> strata(cases);
+
+  for (Eigen::Index i = 0; i < unit_normals.rows(); ++i) {
+    // Randomly permute strata across cases using Fisher-Yates shuffle
+    std::iota(strata.begin(), strata.end(), 0);
+    for (Eigen::Index j = cases - 1; j > 0; --j) {
+      auto k = static_cast<Eigen::Index>(stream_.uniform() * (j + 1));
+      std::swap(strata[j], strata[k]);
+    }
+
+    // Draw uniformly within each stratum and map to unit normal value,
+    // keeping probabilities away from zero where the quantile is infinite
+    for (Eigen::Index j = 0; j < cases; ++j) {
+      double probability =
+          (static_cast<double>(strata[j]) + stream_.uniform()) /
+          static_cast<double>(cases);
+      unit_normals(i, j) = quantile(
+          standard_normal,
+          std::max(probability, std::numeric_limits<double>::min()));
+    }
+  }
+}
+
+void LhsNormalMultiVar::draw_truncated(
+    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>& random_numbers,
+    const Eigen::VectorXd& lower, const Eigen::VectorXd& upper,
+    unsigned int cases) {
+  random_numbers.resize(lower.size(), cases);
+
+  Eigen::MatrixXd candidates;
+  std::size_t num_drawn = 0, num_inside = 0;
+  unsigned int accepted = 0;
+
+  while (accepted < cases) {
+    // Size each Latin hypercube so that about as many candidates as cases
+    // remaining fall within bounds, assuming every candidate is accepted
+    // until one block has been drawn
+    double acceptance_rate =
+        num_drawn == 0 ? 1.0
+                       : std::max(static_cast<double>(num_inside), 1.0) /
+                             static_cast<double>(num_drawn);
+    double block_size =
+        std::ceil(static_cast<double>(cases - accepted) / acceptance_rate);
+    draw(candidates, static_cast<unsigned int>(
+                         std::min(block_size, kMaxLatinHypercubeBlock)));
+
+    Eigen::Array<bool, 1, Eigen::Dynamic> inside =
+        ((candidates.colwise() - lower).array() >= 0.0).colwise().all() &&
+        (((-candidates).colwise() + upper).array() >= 0.0).colwise().all();
+
+    num_drawn += static_cast<std::size_t>(candidates.cols());
+    num_inside += static_cast<std::size_t>(inside.count());
+
+    // Strata are randomly permuted across columns, so keeping the first
+    // accepted columns keeps a random subset of them
+    for (Eigen::Index i = 0; i < candidates.cols() && accepted < cases; ++i) {
+      if (inside(i)) {
+        random_numbers.col(accepted++) = candidates.col(i);
+      }
+    }
+  }
+}
+
+std::string LhsNormalMultiVar::name() const {
+  return "LhsNormalMultiVar";
+}
+}  // namespace numeric_utils
@@ -1,20 +1,21 @@
 #define _USE_MATH_DEFINES
 #include <algorithm>
 #include <cmath>
-#include <ctime>
+#include <cstdint>
+#include <map>
 #include <memory>
 #include <numeric>
 #include <stdexcept>
 #include <string>
 #include <vector>
 // Boost random generator
+#include <boost/math/distributions/normal.hpp>
 #include <boost/random/normal_distribution.hpp>
-#include <boost/random/mersenne_twister.hpp>
 #include <boost/random/uniform_real_distribution.hpp>
-#include <boost/random/variate_generator.hpp>
 // Eigen dense matrices
 #include <Eigen/Dense>
 
+#include "baseline_fitter.h"
 #include "beta_dist.h"
 #include "li_diao_v_h.h"
 #include "factory.h"
@@ -24,12 +25,20 @@
 #include "normal_dist.h"
 #include "normal_multivar.h"
 #include "numeric_utils.h"
+#include "random_stream.h"
+
+namespace {
+// Index of the random streams used to estimate acceptance probabilities,
+// separate from white noise (stream 0) and pulse classification (stream 1)
+const std::uint32_t kAcceptanceStream = 2;
+}  // namespace
 
 stochastic::LiningDiaozemin::LiningDiaozemin(
     stochastic::FaultType faulting, stochastic::SimulationType simulation_type,
     double moment_magnitude, double depth_to_rupt, double rupture_distance,
     double vs30, double s_or_d, unsigned int num_sims,
-    unsigned int num_realizations, bool truncate, int seed_value)
+    unsigned int num_realizations, bool truncate, int seed_value,
+    const std::string& sample_generator)
     : StochasticModel(),
       faulting_{faulting},
       sim_type_{simulation_type},
@@ -45,6 +54,11 @@ stochastic::LiningDiaozemin::LiningDiaozemin(
 {
   model_name_ = "LiningDiaozemin_VH";
 
+  // Seed random streams, choosing a seed if none was specified
+  stream_seed_ = seed_value_ != std::numeric_limits<int>::infinity()
+                     ? static_cast<std::uint64_t>(seed_value_)
+                     : numeric_utils::unique_seed();
+
   switch (sim_type_) {
     case stochastic::SimulationType::NoPulse:
       num_sims_pulse_ = 0;
@@ -64,7 +78,7 @@ stochastic::LiningDiaozemin::LiningDiaozemin(
   // Initialize multivariate normal generator without seed
   sample_generator_ =
       Factory<numeric_utils::RandomGenerator, int>::instance()->create(
-          "MultivariateNormal", std::move(seed_value_));
+          sample_generator, std::move(seed_value_));
   
   // Set regression constants
   std_dev_pulse_.resize(19);
@@ -202,60 +216,80 @@ utilities::JsonObject stochastic::LiningDiaozemin::generate(
       num_sims_nopulse_, std::vector<std::vector<double>>(
                              num_realizations_, std::vector<double>()));
 
+  // Draw new random streams for each unseeded ensemble
+  if (seed_value_ == std::numeric_limits<int>::infinity()) {
+    stream_seed_ = numeric_utils::unique_seed();
+  }
+
+  // Likelihood ratio weights of each set of model parameters
+  Eigen::VectorXd weights_pulse, weights_nopulse;
+
+  // Number of pulse-like and non-pulse-like parameter sets generated, which
+  // are fewer than requested when an adaptive ensemble converges early
+  unsigned int num_pulse = 0, num_nopulse = 0;
+  numeric_utils::OnlineEstimator estimator;
+
   // Generated simulated acceleration time histories
   try {
     // Simulate model parameters
     Eigen::MatrixXd parameters_pulse =
-        simulate_model_parameters(true, num_sims_pulse_);
+        simulate_model_parameters(true, num_sims_pulse_, weights_pulse);
     Eigen::MatrixXd parameters_nopulse =
-        simulate_model_parameters(false, num_sims_nopulse_);
-
-    // Simulate pulse-like motions
-    for (unsigned int i = 0; i < num_sims_pulse_; ++i) {
-        simulate_near_fault_ground_motion(
-            true, parameters_pulse.row(i), pulse_motions_comp1[i],
-            pulse_motions_comp2[i], num_realizations_);
-    } 
+        simulate_model_parameters(false, num_sims_nopulse_, weights_nopulse);
 
-    // Simulate non-pulse-like motions
-    for (unsigned int i = 0; i < num_sims_nopulse_; ++i) {
-      simulate_near_fault_ground_motion(
-          false, parameters_nopulse.row(i), nopulse_motions_comp1[i],
-          nopulse_motions_comp2[i], num_realizations_);
-    }
-
-    // If requested, truncate and baseline correct time histories
+    // Factor converting accelerations to cm/s^2 and order of baseline fit
     double gfactor = 981;
     unsigned int fit_order = 5;
-    if (truncate_) {
-      // First truncate motions
-      for (unsigned int i = 0; i < num_sims_pulse_; ++i) {
-        truncate_time_histories(pulse_motions_comp1[i], pulse_motions_comp2[i],
-                                gfactor);
-      }
-
-      for (unsigned int i = 0; i < num_sims_nopulse_; ++i) {
-        truncate_time_histories(nopulse_motions_comp1[i],
-                                nopulse_motions_comp2[i], gfactor);
+    const unsigned int num_sims = num_sims_pulse_ + num_sims_nopulse_;
+
+    for (unsigned int k = 0; k < num_sims; ++k) {
+      // Adaptive ensembles interleave pulse-like and non-pulse-like parameter
+      // sets in proportion, so the ensemble keeps the predicted proportion of
+      // pulse-like motions wherever generation stops
+      bool pulse_like =
+          adaptive_ensemble()
+              ? num_nopulse == num_sims_nopulse_ ||
+                    (num_pulse < num_sims_pulse_ &&
+                     num_pulse * num_sims < (k + 1) * num_sims_pulse_)
+              : k < num_sims_pulse_;
+      unsigned int i = pulse_like ? num_pulse++ : num_nopulse++;
+      auto& motions_comp1 =
+          pulse_like ? pulse_motions_comp1[i] : nopulse_motions_comp1[i];
+      auto& motions_comp2 =
+          pulse_like ? pulse_motions_comp2[i] : nopulse_motions_comp2[i];
+
+      // Non-pulse-like motions are numbered after pulse-like motions
+      simulate_near_fault_ground_motion(
+          pulse_like,
+          pulse_like ? parameters_pulse.row(i) : parameters_nopulse.row(i),
+          motions_comp1, motions_comp2, num_realizations_,
+          (pulse_like ? i : num_sims_pulse_ + i) * num_realizations_);
+
+      // If requested, truncate and baseline correct time histories
+      if (truncate_) {
+        truncate_time_histories(motions_comp1, motions_comp2, gfactor);
+        baseline_correct_time_histories(motions_comp1, gfactor, fit_order);
+        baseline_correct_time_histories(motions_comp2, gfactor, fit_order);
       }
 
-      // Baseline correct truncated pulse-like motions
-      for (unsigned int i = 0; i < num_sims_pulse_; ++i) {
+      if (adaptive_ensemble()) {
+        // Parameter sets are independent samples, weighted by their
+        // likelihood. Statistics are evaluated in output units.
+        Eigen::VectorXd sample;
         for (unsigned int j = 0; j < num_realizations_; ++j) {
-          baseline_correct_time_history(pulse_motions_comp1[i][j], gfactor,
-                                        fit_order);
-          baseline_correct_time_history(pulse_motions_comp2[i][j], gfactor,
-                                        fit_order);
+          std::vector<std::vector<double>> accels = {motions_comp1[j],
+                                                     motions_comp2[j]};
+          for (auto& accel : accels) {
+            convert_time_history_units(accel, units);
+          }
+          Eigen::VectorXd value = event_statistic(accels, time_step_);
+          sample = j == 0 ? value : Eigen::VectorXd(sample + value);
         }
-      }
+        double weight = pulse_like ? weights_pulse(i) : weights_nopulse(i);
+        estimator.add(weight / num_realizations_ * sample);
 
-      // Baseline correct trunacted non-pulse-like motions
-      for (unsigned int i = 0; i < num_sims_nopulse_; ++i) {
-        for (unsigned int j = 0; j < num_realizations_; ++j) {
-          baseline_correct_time_history(nopulse_motions_comp1[i][j], gfactor,
-                                        fit_order);
-          baseline_correct_time_history(nopulse_motions_comp2[i][j], gfactor,
-                                        fit_order);
+        if (adaptive_converged(estimator)) {
+          break;
         }
       }
     }
@@ -267,7 +301,7 @@ utilities::JsonObject stochastic::LiningDiaozemin::generate(
   // Create JsonObject for events
   auto events = utilities::JsonObject();
   std::vector<utilities::JsonObject> events_array(
-      num_realizations_ * (num_sims_pulse_ + num_sims_nopulse_));
+      num_realizations_ * (num_pulse + num_nopulse));
 
   // Add pattern information for JSON
   auto pattern_x = utilities::JsonObject();
@@ -283,7 +317,7 @@ utilities::JsonObject stochastic::LiningDiaozemin::generate(
   auto event_data = utilities::JsonObject();
   // Loop over simulations for different parameter sets for pulse-like
   // motions
-  for (unsigned int i = 0; i < num_sims_pulse_; ++i) {
+  for (unsigned int i = 0; i < num_pulse; ++i) {
     // Loop over number of realizations per parameter set realization    
     for (unsigned int j = 0; j < num_realizations_; ++j) {
       event_data.add_value("name", event_name + "_ParameterSetPulse" + std::to_string(i) +
@@ -291,6 +325,9 @@ utilities::JsonObject stochastic::LiningDiaozemin::generate(
       event_data.add_value("type", "Seismic");
       event_data.add_value("dT", time_step_);
       event_data.add_value("numSteps", pulse_motions_comp1[i][j].size());
+      if (importance_sampling()) {
+        event_data.add_value("likelihoodWeight", weights_pulse(i));
+      }
       event_data.add_value(
           "pattern", std::vector<utilities::JsonObject>{pattern_x, pattern_z});
 
@@ -320,7 +357,7 @@ utilities::JsonObject stochastic::LiningDiaozemin::generate(
   
   // Loop over different simulations for parameter sets non-pulse-like
   // motions
-  for (unsigned int i = 0; i < num_sims_nopulse_; ++i) {
+  for (unsigned int i = 0; i < num_nopulse; ++i) {
     // Loop over number of realizations per parameter set realization
     for (unsigned int j = 0; j < num_realizations_; ++j) {
       event_data.add_value("name", event_name + "_ParameterSetNoPulse" + std::to_string(i) +
@@ -328,6 +365,9 @@ utilities::JsonObject stochastic::LiningDiaozemin::generate(
       event_data.add_value("type", "Seismic");
       event_data.add_value("dT", time_step_);
       event_data.add_value("numSteps", nopulse_motions_comp1[i][j].size());
+      if (importance_sampling()) {
+        event_data.add_value("likelihoodWeight", weights_nopulse(i));
+      }
       event_data.add_value(
           "pattern", std::vector<utilities::JsonObject>{pattern_x, pattern_z});
 
@@ -351,12 +391,17 @@ utilities::JsonObject stochastic::LiningDiaozemin::generate(
       event_data.add_value("timeSeries", std::vector<utilities::JsonObject>{
                                              time_history_x, time_history_z});
       events_array[i * num_realizations_ + j +
-                   num_realizations_ * num_sims_pulse_] = event_data;
+                   num_realizations_ * num_pulse] = event_data;
       event_data.clear();
     }
   }
 
   events.add_value("Events", events_array);
+  if (adaptive_ensemble()) {
+    events.add_value("AdaptiveEnsemble",
+                     adaptive_summary(estimator, num_realizations_ *
+                                                     (num_pulse + num_nopulse)));
+  }
 
   return events;
 }
@@ -394,22 +439,16 @@ unsigned int stochastic::LiningDiaozemin::simulate_pulse_type(
                                               0.021 * theta_or_phi_));
   }
 
-  // Create random generator for uniform distribution between 0.0 and 1.0
-  auto generator =
-      seed_value_ != std::numeric_limits<int>::infinity()
-          ? boost::random::mt19937(static_cast<unsigned int>(seed_value_))
-          : boost::random::mt19937(
-                static_cast<unsigned int>(std::time(nullptr)));
-
+  // Uniform distribution between 0.0 and 1.0. Each simulation is classified
+  // with a draw from stream 1 of its own random streams, which keeps it
+  // separate from the white noise drawn from stream 0.
   boost::random::uniform_real_distribution<> distribution(0.0, 1.0);
-  boost::random::variate_generator<boost::random::mt19937&,
-                                   boost::random::uniform_real_distribution<>>
-      pulse_gen(generator, distribution);
 
   unsigned int number_of_pulses = 0;
 
   for (unsigned int i = 0; i < num_sims; ++i) {
-    if (pulse_gen() < pulse_probability) {
+    numeric_utils::RandomStream pulse_stream(stream_seed_, i, 0, 1);
+    if (distribution(pulse_stream) < pulse_probability) {
       number_of_pulses++;
     }
   }
@@ -419,6 +458,12 @@ unsigned int stochastic::LiningDiaozemin::simulate_pulse_type(
 
 Eigen::MatrixXd stochastic::LiningDiaozemin::simulate_model_parameters(
     bool pulse_like, unsigned int num_sims) {
+  Eigen::VectorXd weights;
+  return simulate_model_parameters(pulse_like, num_sims, weights);
+}
+
+Eigen::MatrixXd stochastic::LiningDiaozemin::simulate_model_parameters(
+    bool pulse_like, unsigned int num_sims, Eigen::VectorXd& weights) {
   // Calculate covariance matrix
   Eigen::MatrixXd error_cov =
       pulse_like
@@ -437,50 +482,97 @@ Eigen::MatrixXd stochastic::LiningDiaozemin::simulate_model_parameters(
   Eigen::VectorXd predicted_model_params =
       compute_transformed_model_parameters(pulse_like);
 
-  Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic> parameter_realizations;
-  Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic> epsilon;
-
-  // Create simulated model parameters for specified number of motions
-  double test;
-  Eigen::VectorXd model_params(error_mean.size());
+  // Bounds on parameter realizations, which are rejected when any
+  // standardized error is larger than 2
+  Eigen::VectorXd bounds =
+      2.0 * (pulse_like ? std_dev_pulse_ : std_dev_nopulse_);
+
+  // Errors are drawn from proposal centred on region of interest when
+  // importance sampling. Non-pulse-like parameters match the last entries of
+  // the pulse-like parameters.
+  Eigen::VectorXd proposal_mean = error_mean;
+  Eigen::MatrixXd proposal_cov = error_cov;
+  if (importance_sampling()) {
+    if (proposal_shift_.size() != std_dev_pulse_.size()) {
+      throw std::runtime_error(
+          "\nERROR: In stochastic::LiningDiaozemin::"
+          "simulate_model_parameters: Proposal shift must have one value per "
+          "pulse-like model parameter\n");
+    }
+    proposal_mean =
+        proposal_shift_.tail(error_mean.size())
+            .cwiseProduct(pulse_like ? std_dev_pulse_ : std_dev_nopulse_);
+    proposal_cov = proposal_scale_ * proposal_scale_ * error_cov;
+  }
 
-  // Loop over number of simulations requested, generating parameter realizations
-  for (unsigned int i = 0; i < num_sims; ++i) {
-    test = -1.0;
-
-    // Continue looping in event parameters for pulse-like motion are unsatisfactory
-    while (test < 0.0) {
-      sample_generator_->generate(parameter_realizations, error_mean, error_cov,
-                                  1);
-      epsilon = pulse_like
-                    ? parameter_realizations.cwiseQuotient(std_dev_pulse_)
-                    : parameter_realizations.cwiseQuotient(std_dev_nopulse_);
-      double max_epsilon = epsilon.cwiseAbs().maxCoeff();
-
-      while (max_epsilon > 2.0) {
-        sample_generator_->generate(parameter_realizations, error_mean,
-                                    error_cov, 1);
-        epsilon = pulse_like
-                      ? parameter_realizations.cwiseQuotient(std_dev_pulse_)
-                      : parameter_realizations.cwiseQuotient(std_dev_nopulse_);
-        max_epsilon = epsilon.cwiseAbs().maxCoeff();
+  // Truncation and the check on pulse-like parameters accept a different
+  // fraction of realizations from each distribution. Likelihood ratios are
+  // scaled by the ratio of estimated acceptance probabilities, so weights are
+  // those of the truncated model distribution with respect to the truncated
+  // proposal.
+  double acceptance_ratio = 1.0;
+  if (importance_sampling()) {
+    auto accepted_errors = [&](const Eigen::MatrixXd& errors) {
+      Eigen::Array<bool, 1, Eigen::Dynamic> inside =
+          (errors.cwiseAbs().colwise() - bounds).array().colwise().maxCoeff() <=
+          0.0;
+      if (pulse_like) {
+        inside = inside && check_pulse_parameters(
+                               errors.colwise() + predicted_model_params);
       }
+      return inside;
+    };
+
+    // Acceptance probabilities are estimated from a separate random stream,
+    // so estimating them does not advance or re-prepare the seeded sample
+    // generator of model parameters
+    numeric_utils::RandomStream acceptance_stream(
+        stream_seed_, 0, pulse_like ? 1 : 0, kAcceptanceStream);
+    acceptance_ratio = numeric_utils::acceptance_ratio(
+        accepted_errors, error_mean, error_cov, proposal_mean, proposal_cov,
+        acceptance_stream);
+  }
 
-      // Random realization of model parameters in normal space
-      model_params = predicted_model_params + parameter_realizations;
-      // Transform random realization to real space
-      transform_parameters_from_normal_space(pulse_like, model_params);
-
-      // Additional check on pulse-like parameters
-      if (pulse_like) {
-	test = model_params(4) - 0.5 * model_params(1) * model_params(2);
-      } else {
-	test = 1.0;
+  // Decompose covariance matrix once for all realizations drawn while
+  // rejecting unsatisfactory parameters
+  sample_generator_->prepare(proposal_mean, proposal_cov);
+
+  Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic> candidates;
+  unsigned int accepted = 0;
+  weights = Eigen::VectorXd::Ones(num_sims);
+
+  // Draw blocks of candidates within bounds until enough have passed the
+  // additional check on pulse-like parameters
+  while (accepted < num_sims) {
+    sample_generator_->draw_truncated(candidates, -bounds, bounds,
+                                      num_sims - accepted);
+    candidates.colwise() += predicted_model_params;
+
+    Eigen::Array<bool, 1, Eigen::Dynamic> valid =
+        pulse_like ? check_pulse_parameters(candidates)
+                   : Eigen::Array<bool, 1, Eigen::Dynamic>::Constant(
+                         candidates.cols(), true);
+
+    // Transform valid realizations of model parameters to real space
+    Eigen::MatrixXd model_params(candidates.rows(), valid.count());
+    for (Eigen::Index i = 0, j = 0; i < candidates.cols(); ++i) {
+      if (valid(i)) {
+        model_params.col(j++) = candidates.col(i);
       }
     }
 
-    // Set current row of parameter realizations to generated model parameters
-    simulated_params.row(i) = model_params;
+    if (importance_sampling()) {
+      weights.segment(accepted, model_params.cols()) =
+          numeric_utils::normal_likelihood_ratios(
+              model_params.colwise() - predicted_model_params, error_mean,
+              error_cov, proposal_mean, proposal_cov) *
+          acceptance_ratio;
+    }
+    transform_parameters_from_normal_space(pulse_like, model_params);
+
+    simulated_params.middleRows(accepted, model_params.cols()) =
+        model_params.transpose();
+    accepted += static_cast<unsigned int>(model_params.cols());
   }
   
   return simulated_params;
@@ -516,136 +608,94 @@ Eigen::VectorXd
   }
 }
 
-void stochastic::LiningDiaozemin::transform_parameters_from_normal_space(
-    bool pulse_like, Eigen::VectorXd& parameters) {
-  Eigen::VectorXd transformed_params(parameters.size());
-  auto standard_normal =
-      Factory<stochastic::Distribution, double, double>::instance()->create(
-          "NormalDist", std::move(0.0), std::move(1.0));
+Eigen::Array<bool, 1, Eigen::Dynamic>
+    stochastic::LiningDiaozemin::check_pulse_parameters(
+        const Eigen::MatrixXd& parameters) const {
+  // Transform only parameters needed for check to real space, for all
+  // candidates at once
+  Eigen::RowVectorXd gamma = parameters.row(2);
+  transform_from_beta(gamma, 2, false);
 
+  return (parameters.row(4).array().exp() -
+          0.5 * parameters.row(1).array().exp() * gamma.array()) >= 0.0;
+}
+
+void stochastic::LiningDiaozemin::transform_parameters_from_normal_space(
+    bool pulse_like, Eigen::Ref<Eigen::MatrixXd> parameters) {
+  // Each row contains one parameter for all sets of parameters, so each
+  // parameter is transformed for all sets at once
   if (pulse_like) {
     std::vector<unsigned int> indices = {0, 1, 4, 5, 6, 7, 8, 9, 12, 13, 14, 15, 16};
     for (auto const& index : indices) {
-      transformed_params(index) = std::exp(parameters(index));
+      parameters.row(index) = parameters.row(index).array().exp();
     }
 
     // Calculate gamma
-    auto beta_dist =
-        Factory<stochastic::Distribution, double, double>::instance()->create(
-            "BetaDist", std::move(params_fitted1_(2)),
-            std::move(params_fitted2_(2)));
-
-    transformed_params(2) =
-        ((beta_dist->inv_cumulative_dist_func(
-              standard_normal->cumulative_dist_func(
-                  std::vector<double>{parameters(2)})))
-             .at(0)) *
-            (params_upper_bound_(2) - params_lower_bound_(2)) +
-        params_lower_bound_(2);
+    transform_from_beta(parameters.row(2), 2, false);
 
     // Calculate nu
     auto uniform_dist =
         Factory<stochastic::Distribution, double, double>::instance()->create(
             "UniformDist", std::move(params_lower_bound_(3)),
             std::move(params_upper_bound_(3)));
-
-    transformed_params(3) = (uniform_dist->inv_cumulative_dist_func(
-                                 standard_normal->cumulative_dist_func(
-                                     std::vector<double>{parameters(3)})))
-                                .at(0);
+    uniform_dist->transform_from_std_normal(parameters.row(3));
 
     // Calculate f' residual
-    transformed_params(10) =
-        inv_double_exp(standard_normal->cumulative_dist_func(
-                           std::vector<double>{parameters(10)})[0],
-                       params_fitted1_(10), params_fitted2_(10),
-                       params_fitted3_(10), params_lower_bound_(10));
+    transform_from_double_exp(parameters.row(10), 10);
 
     // Calculate depth_to_rupt residual
-    beta_dist =
-        Factory<stochastic::Distribution, double, double>::instance()->create(
-            "BetaDist", std::move(params_fitted1_(11)),
-            std::move(params_fitted2_(11)));
-
-    transformed_params(11) =
-        std::exp(((beta_dist->inv_cumulative_dist_func(
-                       standard_normal->cumulative_dist_func(
-                           std::vector<double>{parameters(11)})))
-                      .at(0)) *
-                     (params_upper_bound_(11) - params_lower_bound_(11)) +
-                 params_lower_bound_(11));
+    transform_from_beta(parameters.row(11), 11, true);
 
     // Calculate f' pulse-only
-    transformed_params(17) =
-        inv_double_exp(standard_normal->cumulative_dist_func(
-                           std::vector<double>{parameters(17)})[0],
-                       params_fitted1_(17), params_fitted2_(17),
-                       params_fitted3_(17), params_lower_bound_(17));
+    transform_from_double_exp(parameters.row(17), 17);
 
     // Calculate depth_to_rupt pulse-only
-    beta_dist =
-        Factory<stochastic::Distribution, double, double>::instance()->create(
-            "BetaDist", std::move(params_fitted1_(18)),
-            std::move(params_fitted2_(18)));
-
-    transformed_params(18) =
-        std::exp(((beta_dist->inv_cumulative_dist_func(
-                       standard_normal->cumulative_dist_func(
-                           std::vector<double>{parameters(18)})))
-                      .at(0)) *
-                     (params_upper_bound_(18) - params_lower_bound_(18)) +
-                 params_lower_bound_(18));
+    transform_from_beta(parameters.row(18), 18, true);
   } else {
     std::vector<unsigned int> indices = {0, 1, 2, 3, 4, 7, 8, 9, 10, 11};
     for (auto const& index : indices) {
-      transformed_params(index) = std::exp(parameters(index));
+      parameters.row(index) = parameters.row(index).array().exp();
     }
 
     // Calculate f' component 1
-    transformed_params(5) =
-        inv_double_exp(standard_normal->cumulative_dist_func(
-                           std::vector<double>{parameters(5)})[0],
-                       params_fitted1_(10), params_fitted2_(10),
-                       params_fitted3_(10), params_lower_bound_(10));
+    transform_from_double_exp(parameters.row(5), 10);
 
     // Calculate depth_to_rupture component 1
-    auto beta_dist =
-        Factory<stochastic::Distribution, double, double>::instance()->create(
-            "BetaDist", std::move(params_fitted1_(11)),
-            std::move(params_fitted2_(11)));
-
-    transformed_params(6) =
-        std::exp(((beta_dist->inv_cumulative_dist_func(
-                       standard_normal->cumulative_dist_func(
-                           std::vector<double>{parameters(6)})))
-                      .at(0)) *
-                     (params_upper_bound_(11) - params_lower_bound_(11)) +
-                 params_lower_bound_(11));
+    transform_from_beta(parameters.row(6), 11, true);
 
     // Calculate f' component 2
-    transformed_params(12) =
-        inv_double_exp(standard_normal->cumulative_dist_func(
-                           std::vector<double>{parameters(12)})[0],
-                       params_fitted1_(17), params_fitted2_(17),
-                       params_fitted3_(17), params_lower_bound_(17));
+    transform_from_double_exp(parameters.row(12), 17);
 
     // Calculate depth_to_rupture compenent 2
-    beta_dist =
-        Factory<stochastic::Distribution, double, double>::instance()->create(
-            "BetaDist", std::move(params_fitted1_(18)),
-            std::move(params_fitted2_(18)));
-
-    transformed_params(13) =
-        std::exp(((beta_dist->inv_cumulative_dist_func(
-                       standard_normal->cumulative_dist_func(
-                           std::vector<double>{parameters(13)})))
-                      .at(0)) *
-                     (params_upper_bound_(18) - params_lower_bound_(18)) +
-                 params_lower_bound_(18));
+    transform_from_beta(parameters.row(13), 18, true);
   }
+}
 
-  // Set input vector of parameters to transformed parameters
-  parameters = transformed_params;
+void stochastic::LiningDiaozemin::transform_from_beta(
+    stochastic::ValuesRef values, unsigned int index,
+    bool exponentiate) const {
+  double alpha = params_fitted1_(index), beta = params_fitted2_(index);
+  auto beta_dist =
+      Factory<stochastic::Distribution, double, double>::instance()->create(
+          "BetaDist", std::move(alpha), std::move(beta));
+  beta_dist->transform_from_std_normal(values);
+
+  // Scale from unit interval to bounds of fitted distribution
+  double lower = params_lower_bound_(index), upper = params_upper_bound_(index);
+  values.array() = values.array() * (upper - lower) + lower;
+  if (exponentiate) {
+    values.array() = values.array().exp();
+  }
+}
+
+void stochastic::LiningDiaozemin::transform_from_double_exp(
+    stochastic::ValuesRef values, unsigned int index) const {
+  const boost::math::normal_distribution<double> standard_normal;
+  values = values.unaryExpr([this, index, &standard_normal](double value) {
+    return inv_double_exp(cdf(standard_normal, value), params_fitted1_(index),
+                          params_fitted2_(index), params_fitted3_(index),
+                          params_lower_bound_(index));
+  });
 }
 
 double stochastic::LiningDiaozemin::inv_double_exp(
@@ -675,7 +725,7 @@ void stochastic::LiningDiaozemin::simulate_near_fault_ground_motion(
     bool pulse_like, const Eigen::VectorXd& parameters,
     std::vector<std::vector<double>>& accel_comp_1,
     std::vector<std::vector<double>>& accel_comp_2,
-    unsigned int num_gms) const {
+    unsigned int num_gms, unsigned int event_index) const {
 
   // Extract parameters for two components of ground motion
   Eigen::VectorXd alpha_1(7);
@@ -709,10 +759,12 @@ void stochastic::LiningDiaozemin::simulate_near_fault_ground_motion(
   num_steps = num_steps % 2 == 1 ? num_steps + 1 : num_steps;
 
   // Generated modulated filtered white noise
-  auto white_noise_1 = simulate_white_noise(
-      modulating_params_1, filter_params_1, num_steps, num_gms);
-  auto white_noise_2 = simulate_white_noise(
-      modulating_params_2, filter_params_2, num_steps, num_gms);
+  auto white_noise_1 =
+      simulate_white_noise(modulating_params_1, filter_params_1, num_steps,
+                           num_gms, event_index, 0);
+  auto white_noise_2 =
+      simulate_white_noise(modulating_params_2, filter_params_2, num_steps,
+                           num_gms, event_index, 1);
 
   // Calculate high-pass filter and padding
   double freq_corner = std::pow(10.0, 1.4071 - 0.3452 * moment_magnitude_);
@@ -744,12 +796,8 @@ void stochastic::LiningDiaozemin::simulate_near_fault_ground_motion(
   }
 
   // Apply filter to padded acceleration time histories
-  accel_comp_1.resize(num_gms);
-  accel_comp_2.resize(num_gms);
-  for (unsigned int i = 0; i < num_gms; ++i) {
-    accel_comp_1[i] = filter_acceleration(accel_padded_1.row(i), freq_corner, filter_order);
-    accel_comp_2[i] = filter_acceleration(accel_padded_2.row(i), freq_corner, filter_order);    
-  }
+  accel_comp_1 = filter_acceleration(accel_padded_1, freq_corner, filter_order);
+  accel_comp_2 = filter_acceleration(accel_padded_2, freq_corner, filter_order);
 
   // Rescale time histories for energy consistency:
   // Target Arias intensity for rescaling after high-pass filter in g-sec
@@ -763,23 +811,15 @@ void stochastic::LiningDiaozemin::simulate_near_fault_ground_motion(
 
   // Calculate Arias intensity
   for (unsigned int i = 0; i < num_gms; ++i) {
-    std::transform(accel_comp_1[i].begin(), accel_comp_1[i].end(),
-                   arias_intensity_1[i].begin(),
-                   [this](double value) -> double {
-                     return value * value * time_step_ * M_PI / 2.0;
-                   });
-
-    std::partial_sum(arias_intensity_1[i].begin(), arias_intensity_1[i].end(),
-                     arias_intensity_1[i].begin());
-
-    std::transform(accel_comp_2[i].begin(), accel_comp_2[i].end(),
-                   arias_intensity_2[i].begin(),
-                   [this](double value) -> double {
-                     return value * value * time_step_ * M_PI / 2.0;
-                   });
-
-    std::partial_sum(arias_intensity_2[i].begin(), arias_intensity_2[i].end(),
-                     arias_intensity_2[i].begin());
+    numeric_utils::cumulative_energy(accel_comp_1[i].data(),
+                                     arias_intensity_1[i].data(),
+                                     accel_comp_1[i].size(), 1,
+                                     time_step_ * M_PI / 2.0);
+
+    numeric_utils::cumulative_energy(accel_comp_2[i].data(),
+                                     arias_intensity_2[i].data(),
+                                     accel_comp_2[i].size(), 1,
+                                     time_step_ * M_PI / 2.0);
   }
 
   // Calculate scaling factors and scale accelerations to match Arias intensity
@@ -935,40 +975,35 @@ double stochastic::LiningDiaozemin::calc_parameter_error(
 Eigen::MatrixXd stochastic::LiningDiaozemin::simulate_white_noise(
     const Eigen::VectorXd& modulating_params,
     const Eigen::VectorXd& filter_params, unsigned int num_steps,
-    unsigned int num_gms) const {
+    unsigned int num_gms, unsigned int event_index,
+    unsigned int component) const {
   // CALCULATE MODULATING FUNCTION:
   auto modulating_func =
       calc_modulating_func(num_steps, start_time_, modulating_params);
 
   // CALCULATE FREQUENCY FUNCTION:
   // For any general modulating function, get the discretized times of interest
-  // Lower bound before t01
-  double t01 = calc_time_to_intensity(modulating_func, 1.0);
-  // Middle set to t30
-  double tmid = calc_time_to_intensity(modulating_func, 30.0);
-  // Upper bound after t99
-  double t99 = calc_time_to_intensity(modulating_func, 99.0);
+  // Lower bound before t01, middle set to t30 and upper bound after t99
+  auto intensity_times =
+      calc_times_to_intensity(modulating_func, {1.0, 30.0, 99.0});
+  double t01 = intensity_times[0];
+  double tmid = intensity_times[1];
+  double t99 = intensity_times[2];
 
   // Define the filter frequency and bandwidth
   auto frequency_filter =
       calc_linear_filter(num_steps, filter_params, t01, tmid, t99);
 
-  // Generate white noise
-  auto generator =
-      seed_value_ != std::numeric_limits<int>::infinity()
-          ? boost::random::mt19937(static_cast<unsigned int>(seed_value_))
-          : boost::random::mt19937(
-                static_cast<unsigned int>(std::time(nullptr)));
-  
+  // Generate white noise, drawing each ground motion from its own random
+  // stream so that motions are independent of the order they are simulated in
   boost::random::normal_distribution<> distribution(0.0, 1.0);
-  boost::random::variate_generator<boost::random::mt19937&,
-                                   boost::random::normal_distribution<>>
-      noise_gen(generator, distribution);
 
   Eigen::MatrixXd white_noise(num_gms, num_steps);
   for (unsigned int i = 0; i < num_gms; ++i) {
+    numeric_utils::RandomStream noise_stream(stream_seed_, event_index + i,
+                                             component);
     for (unsigned int j = 0; j < num_steps; ++j) {
-      white_noise(i, j) = noise_gen();
+      white_noise(i, j) = distribution(noise_stream);
     }
   }
 
@@ -1016,29 +1051,34 @@ std::vector<double> stochastic::LiningDiaozemin::calc_modulating_func(
 
 double stochastic::LiningDiaozemin::calc_time_to_intensity(
     const std::vector<double>& acceleration, double percentage) const {
+  return calc_times_to_intensity(acceleration, {percentage})[0];
+}
+
+std::vector<double> stochastic::LiningDiaozemin::calc_times_to_intensity(
+    const std::vector<double>& acceleration,
+    const std::vector<double>& percentages) const {
   // Calculate cumulative energy in acceleration time series, which is
   // proportional to Arias intensity
-  std::vector<double> t01_sum(acceleration.size());
-
-  std::transform(acceleration.begin(), acceleration.end(), t01_sum.begin(),
-                [](double value) -> double { return value * value; });
-
-  std::partial_sum(t01_sum.begin(), t01_sum.end(), t01_sum.begin());
-
-  // Calculate normalized cumulative Arias intensity in percent
-  std::transform(t01_sum.begin(), t01_sum.end(), t01_sum.begin(),
-                 [&t01_sum](double value) -> double {
-                   return value / t01_sum[t01_sum.size() - 1] * 100.0;
+  std::vector<double> cumulative_energy(acceleration.size());
+  numeric_utils::cumulative_energy(acceleration.data(),
+                                   cumulative_energy.data(),
+                                   acceleration.size(), 1, 1.0);
+
+  // Find indices at which each percentage of the total energy is reached
+  std::vector<double> fractions(percentages.size());
+  std::transform(percentages.begin(), percentages.end(), fractions.begin(),
+                 [](double value) -> double { return value / 100.0; });
+
+  auto crossings = numeric_utils::threshold_crossings(
+      cumulative_energy.data(), cumulative_energy.size(), fractions, true);
+
+  std::vector<double> times(crossings.size());
+  std::transform(crossings.begin(), crossings.end(), times.begin(),
+                 [this](std::size_t index) -> double {
+                   return time_step_ * static_cast<double>(index + 1);
                  });
 
-  return time_step_ *
-         static_cast<double>(
-             std::distance(t01_sum.begin(),
-                           std::find_if(t01_sum.begin(), t01_sum.end(),
-                                        [percentage](double value) {
-                                          return value >= percentage;
-                                        })) +
-             1);
+  return times;
 }
 
 std::vector<double> stochastic::LiningDiaozemin::calc_linear_filter(
@@ -1115,30 +1155,75 @@ std::vector<double> stochastic::LiningDiaozemin::filter_acceleration(
     const Eigen::VectorXd& accel_history, double freq_corner,
     unsigned int filter_order) const {
 
-  // Calculate normalized cutoff frequency
-  std::vector<std::complex<double>> accel_fft(accel_history.size());
-
-  // Compute FFT of acceleration history
-  numeric_utils::fft(accel_history, accel_fft);
+  // Compute half spectrum of acceleration history using real-to-complex FFT
+  std::vector<std::complex<double>> accel_fft;
+  numeric_utils::fft_r2c(accel_history, accel_fft);
 
   // Get filter coefficients
   auto filter = Dispatcher<std::vector<double>, double, double, unsigned int,
                            unsigned int>::instance()
                     ->dispatch("AcausalHighpassButterworth", freq_corner,
-                               time_step_, filter_order, accel_fft.size());
+                               time_step_, filter_order, accel_history.size());
 
-  // Filter acceleration in frequency domain
+  // Filter acceleration in frequency domain. Filter is symmetric, so only
+  // the non-redundant half of the spectrum needs to be filtered
   for (unsigned int i = 0; i < accel_fft.size(); ++i) {
     accel_fft[i] = accel_fft[i] * filter[i];
   }
 
   // Compute inverse FFT of filtered transformed acceleration
-  std::vector<double> filtered_acc(accel_fft.size());
-  numeric_utils::inverse_fft(accel_fft, filtered_acc);
+  std::vector<double> filtered_acc(accel_history.size());
+  numeric_utils::inverse_fft_c2r(accel_fft, filtered_acc,
+                                 accel_history.size());
 
   return filtered_acc;
 }
 
+std::vector<std::vector<double>>
+    stochastic::LiningDiaozemin::filter_acceleration(
+        const Eigen::MatrixXd& accel_histories, double freq_corner,
+        unsigned int filter_order) const {
+  unsigned int num_histories = accel_histories.rows();
+  unsigned int num_steps = accel_histories.cols();
+  unsigned int num_freqs = num_steps / 2 + 1;
+
+  // Each row is a signal, so consecutive elements of a signal are separated
+  // by the number of rows and consecutive signals start one element apart
+  numeric_utils::FftLayout layout(num_histories, num_histories, 1,
+                                  num_histories, 1);
+
+  // Compute half spectra of all acceleration histories in single batch
+  Eigen::MatrixXcd accel_fft(num_histories, num_freqs);
+  numeric_utils::fft_r2c_batch(accel_histories.data(), accel_fft.data(),
+                               num_steps, layout);
+
+  // Get filter coefficients
+  auto filter = Dispatcher<std::vector<double>, double, double, unsigned int,
+                           unsigned int>::instance()
+                    ->dispatch("AcausalHighpassButterworth", freq_corner,
+                               time_step_, filter_order, num_steps);
+
+  // Filter accelerations in frequency domain. Each column holds one frequency
+  // for all histories.
+  for (unsigned int i = 0; i < num_freqs; ++i) {
+    accel_fft.col(i) *= filter[i];
+  }
+
+  // Compute inverse FFTs of filtered transformed accelerations
+  Eigen::MatrixXd filtered_acc(num_histories, num_steps);
+  numeric_utils::inverse_fft_c2r_batch(accel_fft.data(), filtered_acc.data(),
+                                       num_steps, layout);
+
+  std::vector<std::vector<double>> filtered_histories(
+      num_histories, std::vector<double>(num_steps));
+  for (unsigned int i = 0; i < num_histories; ++i) {
+    Eigen::Map<Eigen::RowVectorXd>(filtered_histories[i].data(), num_steps) =
+        filtered_acc.row(i);
+  }
+
+  return filtered_histories;
+}
+
 std::vector<double> stochastic::LiningDiaozemin::calc_pulse_acceleration(
     unsigned int num_steps, const Eigen::VectorXd& parameters) const {
   double pulse_velocity = parameters(0);  
@@ -1187,24 +1272,10 @@ void stochastic::LiningDiaozemin::truncate_time_histories(
   for (unsigned int i = 0; i < accel_comp_1.size(); ++i) {
     // Calculate peak ground displacement (PGD):
     // Component 1
-    std::vector<double> vel_comp_1(accel_comp_1[i].size());
     std::vector<double> disp_comp_1(accel_comp_1[i].size());
-
-    std::transform(accel_comp_1[i].begin(), accel_comp_1[i].end(),
-                   vel_comp_1.begin(),
-                   [&gfactor, this](double value) -> double {
-                     return value * gfactor * time_step_;
-                   });
-
-    std::partial_sum(vel_comp_1.begin(), vel_comp_1.end(),
-                     vel_comp_1.begin());
-
-    std::transform(
-        vel_comp_1.begin(), vel_comp_1.end(), disp_comp_1.begin(),
-        [this](double value) -> double { return value * time_step_; });
-
-    std::partial_sum(disp_comp_1.begin(), disp_comp_1.end(),
-                     disp_comp_1.begin());
+    numeric_utils::cumulative_double_integral(
+        accel_comp_1[i].data(), nullptr, disp_comp_1.data(),
+        accel_comp_1[i].size(), 1, time_step_, gfactor);
 
     double pgd_1 = *std::max_element(disp_comp_1.begin(), disp_comp_1.end());
 
@@ -1212,24 +1283,10 @@ void stochastic::LiningDiaozemin::truncate_time_histories(
         amplitude_lim < pgd_1 * pgd_lim ? amplitude_lim : pgd_1 * pgd_lim;
 
     // Component 2
-    std::vector<double> vel_comp_2(accel_comp_2[i].size());
     std::vector<double> disp_comp_2(accel_comp_2[i].size());
-
-    std::transform(accel_comp_2[i].begin(), accel_comp_2[i].end(),
-                   vel_comp_2.begin(),
-                   [&gfactor, this](double value) -> double {
-                     return value * gfactor * time_step_;
-                   });
-
-    std::partial_sum(vel_comp_2.begin(), vel_comp_2.end(),
-                     vel_comp_2.begin());
-
-    std::transform(
-        vel_comp_2.begin(), vel_comp_2.end(), disp_comp_2.begin(),
-        [this](double value) -> double { return value * time_step_; });
-
-    std::partial_sum(disp_comp_2.begin(), disp_comp_2.end(),
-                     disp_comp_2.begin());
+    numeric_utils::cumulative_double_integral(
+        accel_comp_2[i].data(), nullptr, disp_comp_2.data(),
+        accel_comp_2[i].size(), 1, time_step_, gfactor);
 
     double pgd_2 = *std::max_element(disp_comp_2.begin(), disp_comp_2.end());
 
@@ -1295,49 +1352,42 @@ void stochastic::LiningDiaozemin::truncate_time_histories(
   }
 }
 
-void stochastic::LiningDiaozemin::baseline_correct_time_history(
-    std::vector<double>& time_history, double gfactor,
+void stochastic::LiningDiaozemin::baseline_correct_time_histories(
+    std::vector<std::vector<double>>& time_histories, double gfactor,
     unsigned int order) const {
-
-  // Calculate velocity and displacment time histories
-  std::vector<double> vel_series(time_history.size());
-  std::vector<double> disp_series(time_history.size());
-
-  std::transform(time_history.begin(), time_history.end(), vel_series.begin(),
-                 [&gfactor, this](double value) -> double {
-                   return value * gfactor * time_step_;
-                 });
-
-  std::partial_sum(vel_series.begin(), vel_series.end(), vel_series.begin());
-
-  std::transform(vel_series.begin(), vel_series.end(), disp_series.begin(),
-                 [this](double value) -> double { return value * time_step_; });
-
-  std::partial_sum(disp_series.begin(), disp_series.end(), disp_series.begin());
-
-  Eigen::VectorXd times(time_history.size());
-
-  for (unsigned int i = 0; i < times.size(); ++i) {
-    times(i) = i * time_step_;
+  // Truncated records differ in length, so group records of equal length to
+  // correct each group with a single fit
+  std::map<std::size_t, std::vector<unsigned int>> record_groups;
+  for (unsigned int i = 0; i < time_histories.size(); ++i) {
+    record_groups[time_histories[i].size()].push_back(i);
   }
 
-  // Convert input time history from std vector to Eigen vector
-  Eigen::VectorXd disp_vector =
-      Eigen::Map<Eigen::VectorXd>(disp_series.data(), disp_series.size());
-
-  // Fit zero-intercept polynomial to displacement time history
-  auto displacement_poly =
-    numeric_utils::polyfit_intercept(times, disp_vector, 0.0, 5);
-  auto velocity_poly = numeric_utils::polynomial_derivative(displacement_poly);
-  auto accel_poly = numeric_utils::polynomial_derivative(velocity_poly);
+  for (const auto& group : record_groups) {
+    std::size_t num_points = group.first;
+    const auto& records = group.second;
 
-  // Calculate acceleration correction based on polynomial
-  auto accel_correction =
-      numeric_utils::evaluate_polynomial(accel_poly, times) / gfactor;
+    // Calculate displacement time histories, one record per column
+    Eigen::MatrixXd disp_series(num_points, records.size());
+    for (unsigned int j = 0; j < records.size(); ++j) {
+      numeric_utils::cumulative_double_integral(
+          time_histories[records[j]].data(), nullptr,
+          disp_series.col(j).data(), num_points, 1, time_step_, gfactor);
+    }
 
-  // Correct time series based on acceleration correction
-  for (unsigned int i = 0; i < accel_correction.size(); ++i) {
-    time_history[i] = time_history[i] - accel_correction(i);
+    // Fit zero-intercept polynomial to all displacement time histories and
+    // calculate acceleration correction from its second derivative
+    auto fitter = numeric_utils::BaselineFitterCache::instance()->fitter(
+        num_points, time_step_, order);
+    Eigen::MatrixXd accel_correction =
+        fitter->evaluate(disp_series, 2) / gfactor;
+
+    // Correct time series based on acceleration correction
+    for (unsigned int j = 0; j < records.size(); ++j) {
+      auto& time_history = time_histories[records[j]];
+      for (std::size_t k = 0; k < num_points; ++k) {
+        time_history[k] = time_history[k] - accel_correction(k, j);
+      }
+    }
   }
 }
 
@@ -30,3 +30,10 @@ std::vector<double> stochastic::LognormalDistribution::inv_cumulative_dist_func(
 
   return evaluations;
 }
+
+void stochastic::LognormalDistribution::transform_from_std_normal(
+    ValuesRef values) const {
+  // Quantile of standard normal CDF reduces to exponential of shifted and
+  // scaled values
+  values.array() = (values.array() * std_dev_ + mean_).exp();
+}
@@ -0,0 +1,172 @@
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <mkl_dfti.h>
+#include <mkl_vsl.h>
+#include "mkl_fft.h"
+
+namespace numeric_utils {
+namespace {
+// Throw if VSL convolution stage was not successful
+void check_conv_status(int conv_status, const std::string& stage) {
+  if (conv_status != VSL_STATUS_OK) {
+    throw std::runtime_error(
+        "\nERROR: in numeric_utils::MklFftBackend::convolve: Error in "
+        "convolution " + stage + "\n");
+  }
+}
+}  // namespace
+
+MklFftPlan::MklFftPlan(std::size_t length, FftDirection direction,
+                       FftDomain domain, const FftLayout& layout,
+                       FftPrecision precision)
+    : direction_{direction}, descriptor_{nullptr} {
+  MKL_LONG fft_status = DftiCreateDescriptor(
+      &descriptor_, precision == FftPrecision::Double ? DFTI_DOUBLE : DFTI_SINGLE,
+      domain == FftDomain::Real ? DFTI_REAL : DFTI_COMPLEX, 1,
+      static_cast<MKL_LONG>(length));
+  if (fft_status != DFTI_NO_ERROR) {
+    throw std::runtime_error(
+        "\nERROR: in numeric_utils::MklFftPlan: Error in descriptor creation\n");
+  }
+
+  // Set whether output overwrites input
+  fft_status = DftiSetValue(descriptor_, DFTI_PLACEMENT,
+                            layout.in_place ? DFTI_INPLACE : DFTI_NOT_INPLACE);
+
+  // Describe position of signals in input and output buffers. Strides are
+  // given as {offset, stride} pairs.
+  if (fft_status == DFTI_NO_ERROR &&
+      (layout.input_stride != 1 || layout.output_stride != 1)) {
+    MKL_LONG input_strides[2] = {0,
+                                 static_cast<MKL_LONG>(layout.input_stride)};
+    MKL_LONG output_strides[2] = {
+        0, static_cast<MKL_LONG>(layout.output_stride)};
+    fft_status = DftiSetValue(descriptor_, DFTI_INPUT_STRIDES, input_strides);
+    if (fft_status == DFTI_NO_ERROR) {
+      fft_status =
+          DftiSetValue(descriptor_, DFTI_OUTPUT_STRIDES, output_strides);
+    }
+  }
+
+  if (fft_status == DFTI_NO_ERROR && layout.num_transforms > 1) {
+    fft_status = DftiSetValue(descriptor_, DFTI_NUMBER_OF_TRANSFORMS,
+                              static_cast<MKL_LONG>(layout.num_transforms));
+    if (fft_status == DFTI_NO_ERROR) {
+      fft_status =
+          DftiSetValue(descriptor_, DFTI_INPUT_DISTANCE,
+                       static_cast<MKL_LONG>(layout.input_distance));
+    }
+    if (fft_status == DFTI_NO_ERROR) {
+      fft_status =
+          DftiSetValue(descriptor_, DFTI_OUTPUT_DISTANCE,
+                       static_cast<MKL_LONG>(layout.output_distance));
+    }
+  }
+
+  // Store conjugate-even half spectrum as N/2 + 1 complex values
+  if (fft_status == DFTI_NO_ERROR && domain == FftDomain::Real) {
+    fft_status = DftiSetValue(descriptor_, DFTI_CONJUGATE_EVEN_STORAGE,
+                              DFTI_COMPLEX_COMPLEX);
+  }
+
+  // Set the backward scale factor to be 1 divided by the transform length to
+  // make the backward tranform the inverse of the forward transform
+  if (fft_status == DFTI_NO_ERROR && direction == FftDirection::Backward) {
+    fft_status = DftiSetValue(descriptor_, DFTI_BACKWARD_SCALE,
+                              1.0 / static_cast<double>(length));
+  }
+
+  if (fft_status != DFTI_NO_ERROR) {
+    DftiFreeDescriptor(&descriptor_);
+    throw std::runtime_error(
+        "\nERROR: in numeric_utils::MklFftPlan: Error in setting configuration\n");
+  }
+
+  // Perform all initialization for the actual FFT computation
+  fft_status = DftiCommitDescriptor(descriptor_);
+  if (fft_status != DFTI_NO_ERROR) {
+    DftiFreeDescriptor(&descriptor_);
+    throw std::runtime_error(
+        "\nERROR: in numeric_utils::MklFftPlan: Error in committing descriptor\n");
+  }
+}
+
+MklFftPlan::~MklFftPlan() {
+  if (descriptor_) {
+    DftiFreeDescriptor(&descriptor_);
+  }
+}
+
+void MklFftPlan::compute(const void* input, void* output) const {
+  // MKL takes non-const input pointers but does not modify input for
+  // out-of-place transforms
+  MKL_LONG fft_status;
+  if (output == nullptr) {
+    fft_status =
+        direction_ == FftDirection::Forward
+            ? DftiComputeForward(descriptor_, const_cast<void*>(input))
+            : DftiComputeBackward(descriptor_, const_cast<void*>(input));
+  } else {
+    fft_status =
+        direction_ == FftDirection::Forward
+            ? DftiComputeForward(descriptor_, const_cast<void*>(input), output)
+            : DftiComputeBackward(descriptor_, const_cast<void*>(input),
+                                  output);
+  }
+
+  if (fft_status != DFTI_NO_ERROR) {
+    throw std::runtime_error(
+        "\nERROR: in numeric_utils::MklFftPlan::compute: Error in computing "
+        "FFT\n");
+  }
+}
+
+std::unique_ptr<FftBackendPlan> MklFftBackend::create_plan(
+    std::size_t length, FftDirection direction, FftDomain domain,
+    const FftLayout& layout, FftPrecision precision) const {
+  return std::unique_ptr<FftBackendPlan>(
+      new MklFftPlan(length, direction, domain, layout, precision));
+}
+
+void MklFftBackend::convolve(const double* input_x, std::size_t size_x,
+                             const double* input_y, std::size_t size_y,
+                             double* response) const {
+  // Create convolution status and task pointer
+  int conv_status;
+  VSLConvTaskPtr conv_task;
+  // Construct convolution task, with solution mode set to direct
+  conv_status = vsldConvNewTask1D(&conv_task, VSL_CONV_MODE_DIRECT, size_x,
+                                  size_y, size_x + size_y - 1);
+  check_conv_status(conv_status, "construction");
+
+  // Set convolution to start at first element in input_y
+  vslConvSetStart(conv_task, 0);
+
+  // Execute convolution
+  conv_status =
+      vsldConvExec1D(conv_task, input_x, 1, input_y, 1, response, 1);
+
+  // Delete convolution task
+  vslConvDeleteTask(&conv_task);
+  check_conv_status(conv_status, "execution");
+}
+
+void MklFftBackend::convolve(const float* input_x, std::size_t size_x,
+                             const float* input_y, std::size_t size_y,
+                             float* response) const {
+  int conv_status;
+  VSLConvTaskPtr conv_task;
+  conv_status = vslsConvNewTask1D(&conv_task, VSL_CONV_MODE_DIRECT, size_x,
+                                  size_y, size_x + size_y - 1);
+  check_conv_status(conv_status, "construction");
+
+  vslConvSetStart(conv_task, 0);
+
+  conv_status =
+      vslsConvExec1D(conv_task, input_x, 1, input_y, 1, response, 1);
+
+  vslConvDeleteTask(&conv_task);
+  check_conv_status(conv_status, "execution");
+}
+}  // namespace numeric_utils
@@ -0,0 +1,472 @@
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "native_fft.h"
+
+namespace numeric_utils {
+namespace {
+// Largest prime factor handled by mixed-radix passes before switching to
+// Bluestein's algorithm
+const std::size_t kMaxRadix = 32;
+
+// Complex multiplication without the special handling of infinities that
+// std::complex operator* performs, which prevents inlining and vectorization
+template <typename T>
+inline std::complex<T> multiply(const std::complex<T>& a,
+                                const std::complex<T>& b) {
+  return std::complex<T>(a.real() * b.real() - a.imag() * b.imag(),
+                         a.real() * b.imag() + a.imag() * b.real());
+}
+
+// Full convolution by direct summation
+template <typename T>
+void direct_convolution(const T* input_x, std::size_t size_x, const T* input_y,
+                        std::size_t size_y, T* response) {
+  std::fill(response, response + size_x + size_y - 1, T(0));
+
+  for (std::size_t i = 0; i < size_x; ++i) {
+    const T scale = input_x[i];
+    T* shifted_response = response + i;
+    for (std::size_t j = 0; j < size_y; ++j) {
+      shifted_response[j] += scale * input_y[j];
+    }
+  }
+}
+
+// Exponential of i * angle computed in double precision
+template <typename T>
+inline std::complex<T> unit_phasor(double angle) {
+  return std::complex<T>(static_cast<T>(std::cos(angle)),
+                         static_cast<T>(std::sin(angle)));
+}
+}  // namespace
+
+template <typename T>
+NativeComplexFft<T>::NativeComplexFft(std::size_t length,
+                                      FftDirection direction)
+    : length_{length},
+      sign_{direction == FftDirection::Forward ? T(-1) : T(1)} {
+  const double pi = std::acos(-1.0);
+
+  // Factor length, pulling out radix 4 passes first since they require the
+  // fewest operations per point
+  std::vector<std::size_t> factors;
+  std::size_t remaining = length_;
+  while (remaining % 4 == 0) {
+    factors.push_back(4);
+    remaining /= 4;
+  }
+  if (remaining % 2 == 0) {
+    factors.push_back(2);
+    remaining /= 2;
+  }
+  for (std::size_t factor = 3; factor * factor <= remaining; factor += 2) {
+    while (remaining % factor == 0) {
+      factors.push_back(factor);
+      remaining /= factor;
+    }
+  }
+  if (remaining > 1) {
+    factors.push_back(remaining);
+  }
+
+  // Generic butterflies cost O(radix) per point, so large prime factors are
+  // handled as a convolution using power of two transforms instead
+  if (!factors.empty() &&
+      *std::max_element(factors.begin(), factors.end()) > kMaxRadix) {
+    std::size_t convolution_length = 1;
+    while (convolution_length < 2 * length_ - 1) {
+      convolution_length *= 2;
+    }
+    convolution_fft_.reset(
+        new NativeComplexFft<T>(convolution_length, FftDirection::Forward));
+
+    // Reduce k^2 modulo 2N before scaling to keep the chirp phase accurate
+    // for long transforms
+    chirp_.resize(length_);
+    for (std::size_t k = 0; k < length_; ++k) {
+      unsigned long long square =
+          (static_cast<unsigned long long>(k) * k) % (2 * length_);
+      chirp_[k] = unit_phasor<T>(sign_ * pi * static_cast<double>(square) /
+                                 static_cast<double>(length_));
+    }
+
+    std::vector<std::complex<T>> kernel(convolution_length,
+                                        std::complex<T>(0, 0));
+    std::vector<std::complex<T>> work(convolution_fft_->work_size());
+    kernel[0] = std::conj(chirp_[0]);
+    for (std::size_t k = 1; k < length_; ++k) {
+      kernel[k] = std::conj(chirp_[k]);
+      kernel[convolution_length - k] = std::conj(chirp_[k]);
+    }
+    convolution_fft_->transform(kernel.data(), work.data());
+
+    // Fold scaling of inverse convolution transform into kernel spectrum
+    chirp_spectrum_.resize(convolution_length);
+    T scale = T(1) / static_cast<T>(convolution_length);
+    for (std::size_t k = 0; k < convolution_length; ++k) {
+      chirp_spectrum_[k] = kernel[k] * scale;
+    }
+    return;
+  }
+
+  std::size_t sub_length = length_;
+  std::size_t stride = 1;
+  for (auto radix : factors) {
+    Stage stage;
+    stage.radix = radix;
+    stage.sub_length = sub_length;
+    stage.stride = stride;
+    stage.twiddle_offset = twiddles_.size();
+
+    std::size_t num_butterflies = sub_length / radix;
+    for (std::size_t j = 0; j < num_butterflies; ++j) {
+      for (std::size_t k = 1; k < radix; ++k) {
+        twiddles_.push_back(unit_phasor<T>(
+            sign_ * 2.0 * pi * static_cast<double>(j * k) /
+            static_cast<double>(sub_length)));
+      }
+    }
+
+    stage.roots_offset = twiddles_.size();
+    for (std::size_t k = 0; k < radix; ++k) {
+      twiddles_.push_back(unit_phasor<T>(sign_ * 2.0 * pi *
+                                         static_cast<double>(k) /
+                                         static_cast<double>(radix)));
+    }
+
+    stages_.push_back(stage);
+    sub_length = num_butterflies;
+    stride *= radix;
+  }
+}
+
+template <typename T>
+std::size_t NativeComplexFft<T>::work_size() const {
+  if (convolution_fft_) {
+    return convolution_fft_->length() + convolution_fft_->work_size();
+  }
+  return length_;
+}
+
+template <typename T>
+void NativeComplexFft<T>::transform(std::complex<T>* data,
+                                    std::complex<T>* work) const {
+  if (convolution_fft_) {
+    bluestein(data, work);
+    return;
+  }
+
+  // Stockham passes alternate between data and work, producing output in
+  // natural order without a separate bit reversal
+  std::complex<T>* input = data;
+  std::complex<T>* output = work;
+  for (const auto& stage : stages_) {
+    run_stage(stage, input, output);
+    std::swap(input, output);
+  }
+
+  if (input != data) {
+    std::copy(input, input + length_, data);
+  }
+}
+
+template <typename T>
+void NativeComplexFft<T>::run_stage(const Stage& stage,
+                                    const std::complex<T>* input,
+                                    std::complex<T>* output) const {
+  typedef std::complex<T> Complex;
+  const std::size_t radix = stage.radix;
+  const std::size_t stride = stage.stride;
+  const std::size_t num_butterflies = stage.sub_length / radix;
+  // Distance between butterfly inputs
+  const std::size_t span = stride * num_butterflies;
+  const Complex* twiddles = twiddles_.data() + stage.twiddle_offset;
+
+  switch (radix) {
+    case 2:
+      for (std::size_t j = 0; j < num_butterflies; ++j) {
+        const Complex w1 = twiddles[j];
+        const Complex* in = input + stride * j;
+        Complex* out = output + stride * 2 * j;
+        for (std::size_t q = 0; q < stride; ++q) {
+          Complex a0 = in[q], a1 = in[q + span];
+          out[q] = a0 + a1;
+          out[q + stride] = multiply(a0 - a1, w1);
+        }
+      }
+      break;
+
+    case 3: {
+      const T half_sqrt3 = sign_ * static_cast<T>(std::sqrt(3.0) / 2.0);
+      for (std::size_t j = 0; j < num_butterflies; ++j) {
+        const Complex w1 = twiddles[2 * j], w2 = twiddles[2 * j + 1];
+        const Complex* in = input + stride * j;
+        Complex* out = output + stride * 3 * j;
+        for (std::size_t q = 0; q < stride; ++q) {
+          Complex a0 = in[q], a1 = in[q + span], a2 = in[q + 2 * span];
+          Complex sum = a1 + a2;
+          Complex diff = a1 - a2;
+          Complex mid = a0 - sum * T(0.5);
+          Complex rot(-half_sqrt3 * diff.imag(), half_sqrt3 * diff.real());
+          out[q] = a0 + sum;
+          out[q + stride] = multiply(mid + rot, w1);
+          out[q + 2 * stride] = multiply(mid - rot, w2);
+        }
+      }
+      break;
+    }
+
+    case 4:
+      for (std::size_t j = 0; j < num_butterflies; ++j) {
+        const Complex w1 = twiddles[3 * j], w2 = twiddles[3 * j + 1],
+                      w3 = twiddles[3 * j + 2];
+        const Complex* in = input + stride * j;
+        Complex* out = output + stride * 4 * j;
+        for (std::size_t q = 0; q < stride; ++q) {
+          Complex a0 = in[q], a1 = in[q + span], a2 = in[q + 2 * span],
+                  a3 = in[q + 3 * span];
+          Complex t0 = a0 + a2, t1 = a0 - a2, t2 = a1 + a3, diff = a1 - a3;
+          // Multiply difference by -i for forward and i for backward
+          Complex t3(-sign_ * diff.imag(), sign_ * diff.real());
+          out[q] = t0 + t2;
+          out[q + stride] = multiply(t1 + t3, w1);
+          out[q + 2 * stride] = multiply(t0 - t2, w2);
+          out[q + 3 * stride] = multiply(t1 - t3, w3);
+        }
+      }
+      break;
+
+    default: {
+      const Complex* roots = twiddles_.data() + stage.roots_offset;
+      Complex values[kMaxRadix];
+      for (std::size_t j = 0; j < num_butterflies; ++j) {
+        const Complex* butterfly_twiddles = twiddles + (radix - 1) * j;
+        const Complex* in = input + stride * j;
+        Complex* out = output + stride * radix * j;
+        for (std::size_t q = 0; q < stride; ++q) {
+          for (std::size_t r = 0; r < radix; ++r) {
+            values[r] = in[q + r * span];
+          }
+          for (std::size_t k = 0; k < radix; ++k) {
+            Complex sum = values[0];
+            std::size_t index = 0;
+            for (std::size_t r = 1; r < radix; ++r) {
+              index += k;
+              if (index >= radix) {
+                index -= radix;
+              }
+              sum += multiply(values[r], roots[index]);
+            }
+            out[q + k * stride] =
+                k == 0 ? sum : multiply(sum, butterfly_twiddles[k - 1]);
+          }
+        }
+      }
+      break;
+    }
+  }
+}
+
+template <typename T>
+void NativeComplexFft<T>::bluestein(std::complex<T>* data,
+                                    std::complex<T>* work) const {
+  const std::size_t convolution_length = convolution_fft_->length();
+  std::complex<T>* sequence = work;
+  std::complex<T>* convolution_work = work + convolution_length;
+
+  for (std::size_t k = 0; k < length_; ++k) {
+    sequence[k] = multiply(data[k], chirp_[k]);
+  }
+  std::fill(sequence + length_, sequence + convolution_length,
+            std::complex<T>(0, 0));
+
+  // Circular convolution with the chirp using the forward transform for both
+  // directions, since conj(FFT(conj(x))) is the unscaled inverse transform
+  convolution_fft_->transform(sequence, convolution_work);
+  for (std::size_t k = 0; k < convolution_length; ++k) {
+    sequence[k] = std::conj(multiply(sequence[k], chirp_spectrum_[k]));
+  }
+  convolution_fft_->transform(sequence, convolution_work);
+
+  for (std::size_t k = 0; k < length_; ++k) {
+    data[k] = multiply(std::conj(sequence[k]), chirp_[k]);
+  }
+}
+
+template <typename T>
+NativeFftPlan<T>::NativeFftPlan(std::size_t length, FftDirection direction,
+                                FftDomain domain, const FftLayout& layout)
+    : length_{length},
+      direction_{direction},
+      domain_{domain},
+      layout_{layout},
+      scale_{direction == FftDirection::Backward
+                 ? T(1) / static_cast<T>(length)
+                 : T(1)},
+      fft_{domain == FftDomain::Real && length % 2 == 0 ? length / 2 : length,
+           direction} {
+  // Even length real signals are packed into complex signals of half the
+  // length, so twiddles are needed to separate the even and odd parts
+  if (domain_ == FftDomain::Real && length_ % 2 == 0) {
+    const double pi = std::acos(-1.0);
+    real_twiddles_.resize(length_ / 2);
+    for (std::size_t k = 0; k < real_twiddles_.size(); ++k) {
+      real_twiddles_[k] = unit_phasor<T>(-2.0 * pi * static_cast<double>(k) /
+                                         static_cast<double>(length_));
+    }
+  }
+}
+
+template <typename T>
+void NativeFftPlan<T>::compute(const void* input, void* output) const {
+  typedef std::complex<T> Complex;
+
+  if (output == nullptr) {
+    output = const_cast<void*>(input);
+  }
+
+  // Scratch space is reused between calls on the same thread
+  const std::size_t signal_size = fft_.length();
+  const std::size_t spectrum_size = length_ / 2 + 1;
+  thread_local std::vector<Complex> scratch;
+  if (scratch.size() < signal_size + spectrum_size + fft_.work_size()) {
+    scratch.resize(signal_size + spectrum_size + fft_.work_size());
+  }
+  Complex* signal = scratch.data();
+  Complex* spectrum = signal + signal_size;
+  Complex* work = spectrum + spectrum_size;
+
+  const std::size_t in_stride = layout_.input_stride;
+  const std::size_t out_stride = layout_.output_stride;
+  const bool even = length_ % 2 == 0;
+  const std::size_t half_length = length_ / 2;
+
+  for (std::size_t t = 0; t < layout_.num_transforms; ++t) {
+    if (domain_ == FftDomain::Complex) {
+      const Complex* in =
+          static_cast<const Complex*>(input) + t * layout_.input_distance;
+      Complex* out = static_cast<Complex*>(output) + t * layout_.output_distance;
+
+      for (std::size_t i = 0; i < length_; ++i) {
+        signal[i] = in[i * in_stride];
+      }
+      fft_.transform(signal, work);
+      for (std::size_t i = 0; i < length_; ++i) {
+        out[i * out_stride] = signal[i] * scale_;
+      }
+    } else if (direction_ == FftDirection::Forward) {
+      const T* in = static_cast<const T*>(input) + t * layout_.input_distance;
+      Complex* out = static_cast<Complex*>(output) + t * layout_.output_distance;
+
+      if (even) {
+        // Transform even and odd samples together as real and imaginary parts
+        for (std::size_t j = 0; j < half_length; ++j) {
+          signal[j] = Complex(in[2 * j * in_stride], in[(2 * j + 1) * in_stride]);
+        }
+        fft_.transform(signal, work);
+
+        spectrum[0] = Complex(signal[0].real() + signal[0].imag(), 0);
+        spectrum[half_length] =
+            Complex(signal[0].real() - signal[0].imag(), 0);
+        for (std::size_t k = 1; k < half_length; ++k) {
+          Complex packed = signal[k];
+          Complex mirror = std::conj(signal[half_length - k]);
+          Complex even_part = (packed + mirror) * T(0.5);
+          Complex diff = (packed - mirror) * T(0.5);
+          // Odd part is the difference divided by i
+          Complex odd_part(diff.imag(), -diff.real());
+          spectrum[k] = even_part + multiply(real_twiddles_[k], odd_part);
+        }
+      } else {
+        for (std::size_t i = 0; i < length_; ++i) {
+          signal[i] = Complex(in[i * in_stride], 0);
+        }
+        fft_.transform(signal, work);
+        std::copy(signal, signal + spectrum_size, spectrum);
+      }
+
+      for (std::size_t k = 0; k < spectrum_size; ++k) {
+        out[k * out_stride] = spectrum[k];
+      }
+    } else {
+      const Complex* in =
+          static_cast<const Complex*>(input) + t * layout_.input_distance;
+      T* out = static_cast<T*>(output) + t * layout_.output_distance;
+
+      for (std::size_t k = 0; k < spectrum_size; ++k) {
+        spectrum[k] = in[k * in_stride];
+      }
+
+      // Imaginary parts of the zero and Nyquist frequency terms are ignored
+      if (even) {
+        T zero = spectrum[0].real(), nyquist = spectrum[half_length].real();
+        signal[0] = Complex((zero + nyquist) * T(0.5), (zero - nyquist) * T(0.5));
+        for (std::size_t k = 1; k < half_length; ++k) {
+          Complex value = spectrum[k];
+          Complex mirror = std::conj(spectrum[half_length - k]);
+          Complex even_part = (value + mirror) * T(0.5);
+          Complex odd_part =
+              multiply((value - mirror) * T(0.5), std::conj(real_twiddles_[k]));
+          // Pack as even part plus i times odd part
+          signal[k] = Complex(even_part.real() - odd_part.imag(),
+                              even_part.imag() + odd_part.real());
+        }
+        fft_.transform(signal, work);
+
+        // Half length transform carries half the normalization of the full
+        // length transform
+        T factor = T(2) * scale_;
+        for (std::size_t j = 0; j < half_length; ++j) {
+          out[2 * j * out_stride] = signal[j].real() * factor;
+          out[(2 * j + 1) * out_stride] = signal[j].imag() * factor;
+        }
+      } else {
+        signal[0] = Complex(spectrum[0].real(), 0);
+        for (std::size_t k = 1; k < spectrum_size; ++k) {
+          signal[k] = spectrum[k];
+          signal[length_ - k] = std::conj(spectrum[k]);
+        }
+        fft_.transform(signal, work);
+        for (std::size_t i = 0; i < length_; ++i) {
+          out[i * out_stride] = signal[i].real() * scale_;
+        }
+      }
+    }
+  }
+}
+
+std::unique_ptr<FftBackendPlan> NativeFftBackend::create_plan(
+    std::size_t length, FftDirection direction, FftDomain domain,
+    const FftLayout& layout, FftPrecision precision) const {
+  if (precision == FftPrecision::Double) {
+    return std::unique_ptr<FftBackendPlan>(
+        new NativeFftPlan<double>(length, direction, domain, layout));
+  } else {
+    return std::unique_ptr<FftBackendPlan>(
+        new NativeFftPlan<float>(length, direction, domain, layout));
+  }
+}
+
+void NativeFftBackend::convolve(const double* input_x, std::size_t size_x,
+                                const double* input_y, std::size_t size_y,
+                                double* response) const {
+  direct_convolution(input_x, size_x, input_y, size_y, response);
+}
+
+void NativeFftBackend::convolve(const float* input_x, std::size_t size_x,
+                                const float* input_y, std::size_t size_y,
+                                float* response) const {
+  direct_convolution(input_x, size_x, input_y, size_y, response);
+}
+
+// Explicit instantiations for supported precisions
+template class NativeComplexFft<float>;
+template class NativeComplexFft<double>;
+template class NativeFftPlan<float>;
+template class NativeFftPlan<double>;
+}  // namespace numeric_utils
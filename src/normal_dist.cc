@@ -30,3 +30,9 @@ std::vector<double> stochastic::NormalDistribution::inv_cumulative_dist_func(
 
   return evaluations;
 }
+
+void stochastic::NormalDistribution::transform_from_std_normal(
+    ValuesRef values) const {
+  // Quantile of standard normal CDF reduces to shifting and scaling
+  values.array() = values.array() * std_dev_ + mean_;
+}
@@ -1,8 +1,6 @@
+#include <cstdint>
 #include <iostream>
 #include <stdexcept>
-// Boost random generator
-#include <boost/random/mersenne_twister.hpp>
-#include <boost/random/normal_distribution.hpp>
 // Eigen dense matrices
 #include <Eigen/Dense>
 
@@ -12,59 +10,156 @@
 namespace numeric_utils {
 
 NormalMultiVar::NormalMultiVar()
-  : RandomGenerator()
+  : RandomGenerator(),
+    stream_{static_cast<std::uint64_t>(seed_), 0}
 {
-  generator_ = boost::random::mt19937(seed_);
-  distribution_ = boost::random::normal_distribution<double>();
 }
 
 NormalMultiVar::NormalMultiVar(int seed)
-  : RandomGenerator()
+  : RandomGenerator(),
+    stream_{static_cast<std::uint64_t>(seed), 0}
 {
   seed_ = seed;
-  generator_ = boost::random::mt19937(seed_);
-  distribution_ = boost::random::normal_distribution<double>();
 }
 
+namespace {
+// Relative tolerance on negative eigenvalues of a covariance matrix that is
+// still treated as positive semi-definite
+const double kSemiDefiniteTolerance = 1.0e-10;
+}  // namespace
+
 bool NormalMultiVar::generate(
     Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>& random_numbers,
     const Eigen::VectorXd& means, const Eigen::MatrixXd& cov,
     unsigned int cases) {
+  Eigen::MatrixXd factor;
+  bool lower_triangular;
+  bool success = decompose(cov, factor, lower_triangular);
+
+  transform_normals(random_numbers, means, factor, lower_triangular, cases);
+
+  return success;
+}
+
+bool NormalMultiVar::generate(
+    Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic>& random_numbers,
+    const Eigen::VectorXf& means, const Eigen::MatrixXf& cov,
+    unsigned int cases) {
+  // Decompose in double precision since single precision Cholesky loses
+  // positive definiteness for nearly singular covariance matrices
+  Eigen::MatrixXd factor;
+  bool lower_triangular;
+  bool success = decompose(cov.cast<double>(), factor, lower_triangular);
+
+  Eigen::MatrixXf factor_single = factor.cast<float>();
+  transform_normals(random_numbers, means, factor_single, lower_triangular,
+                    cases);
+
+  return success;
+}
+
+bool NormalMultiVar::prepare(const Eigen::VectorXd& means,
+                             const Eigen::MatrixXd& cov) {
+  RandomGenerator::prepare(means, cov);
+
+  return decompose(cov, prepared_factor_, prepared_lower_triangular_);
+}
+
+void NormalMultiVar::draw(
+    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>& random_numbers,
+    unsigned int cases) {
+  if (prepared_factor_.size() == 0 ||
+      prepared_factor_.rows() != prepared_means_.size()) {
+    throw std::runtime_error(
+        "\nERROR: In NormalMultiVar::draw method: No distribution has been "
+        "prepared for drawing realizations\n");
+  }
 
+  transform_normals(random_numbers, prepared_means_, prepared_factor_,
+                    prepared_lower_triangular_, cases);
+}
+
+bool NormalMultiVar::decompose(const Eigen::MatrixXd& cov,
+                               Eigen::MatrixXd& factor,
+                               bool& lower_triangular) const {
   bool success = true;
-  Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic> lower_cholesky;
-  
+
+  auto llt = cov.llt();
+  factor = llt.matrixL();
+  lower_triangular = true;
+
+  if (llt.info() == Eigen::Success) {
+    return success;
+  }
+
+  // Cholesky decomposition fails for singular covariance matrices, so fall
+  // back to decompositions that allow zero variance in some directions
+  double tolerance =
+      kSemiDefiniteTolerance * cov.diagonal().cwiseAbs().maxCoeff();
+
   try {
-    auto llt = cov.llt();
-    lower_cholesky = llt.matrixL();
+    // Pivoted LDLT gives cov = P^T * L * D * L^T * P
+    Eigen::LDLT<Eigen::MatrixXd> ldlt(cov);
+    if (ldlt.info() == Eigen::Success &&
+        ldlt.vectorD().minCoeff() >= -tolerance) {
+      Eigen::MatrixXd scaled_lower = ldlt.matrixL();
+      scaled_lower *= ldlt.vectorD().cwiseMax(0.0).cwiseSqrt().asDiagonal();
+      factor = ldlt.transpositionsP().transpose() * scaled_lower;
+      lower_triangular = false;
+      return success;
+    }
 
-    if (llt.info() == Eigen::NumericalIssue) {
-      throw std::runtime_error(
-          "\nERROR: In NormalMultivar::generate method: Input covariance matrix is not "
-          "positive semi-definite\n");
+    // LDLT without full pivoting can misjudge nearly singular matrices, so
+    // check the eigenvalues before rejecting the covariance matrix
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eigen_solver(cov);
+    if (eigen_solver.info() == Eigen::Success &&
+        eigen_solver.eigenvalues().minCoeff() >= -tolerance) {
+      factor =
+          eigen_solver.eigenvectors() *
+          eigen_solver.eigenvalues().cwiseMax(0.0).cwiseSqrt().asDiagonal();
+      lower_triangular = false;
+      return success;
     }
+
+    throw std::runtime_error(
+        "\nERROR: In NormalMultivar::generate method: Input covariance matrix "
+        "is not positive semi-definite\n");
   } catch (const std::exception& e) {
     std::cerr << "\nERROR: In normal multivariate random number generation: "
               << e.what() << std::endl;
+    factor = llt.matrixL();
+    lower_triangular = true;
     success = false;
   }
 
-  random_numbers.resize(cov.rows(), cases);
+  return success;
+}
 
-  // Generate random numbers based on distribution and generator type for
-  // requested number of cases
-  for (unsigned int i = 0; i < random_numbers.cols(); ++i) {
-    for (unsigned int j = 0; j < random_numbers.rows(); ++j) {
-      random_numbers(j, i) = distribution_(generator_);
-    }
-  }
+template <typename T>
+void NormalMultiVar::transform_normals(
+    Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& random_numbers,
+    const Eigen::Matrix<T, Eigen::Dynamic, 1>& means,
+    const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& factor,
+    bool lower_triangular, unsigned int cases) {
+  // Generate unit normal values for all requested cases as one block. Values
+  // are always drawn in double precision so that both precisions consume the
+  // same random stream.
+  Eigen::MatrixXd unit_normals(factor.cols(), cases);
+  fill_unit_normals(unit_normals);
 
   // Transform from unit normal distribution based on covariance and mean values
-  for (unsigned int i = 0; i < random_numbers.cols(); ++i) {
-    random_numbers.col(i) = lower_cholesky * random_numbers.col(i) + means;
+  if (lower_triangular) {
+    random_numbers.noalias() =
+        factor.template triangularView<Eigen::Lower>() *
+        unit_normals.template cast<T>();
+  } else {
+    random_numbers.noalias() = factor * unit_normals.template cast<T>();
   }
+  random_numbers.colwise() += means;
+}
 
-  return success;
+void NormalMultiVar::fill_unit_normals(Eigen::MatrixXd& unit_normals) {
+  stream_.fill_normal(unit_normals.data(), unit_normals.size());
 }
 
 std::string NormalMultiVar::name() const {
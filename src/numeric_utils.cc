@@ -1,10 +1,12 @@
+#define _USE_MATH_DEFINES
+#include <algorithm>
+#include <cmath>
 #include <complex>
 #include <iostream>
+#include <numeric>
 #include <stdexcept>
 #include <Eigen/Dense>
-#include <mkl.h>
-#include <mkl_dfti.h>
-#include <mkl_vsl.h>
+#include "convolution_kernel.h"
 #include "numeric_utils.h"
 
 namespace numeric_utils {
@@ -20,264 +22,616 @@ Eigen::MatrixXd corr_to_cov(const Eigen::MatrixXd& corr,
 
   return cov_matrix;
 }
-  
-bool convolve_1d(const std::vector<double>& input_x,
-                 const std::vector<double>& input_y,
-                 std::vector<double>& response) {
-  bool status = true;
-  response.resize(input_x.size() + input_y.size() - 1);
-
-  // Create convolution status and task pointer
-  int conv_status;
-  VSLConvTaskPtr conv_task;
-  // Construct convolution task, with solution mode set to direct
-  conv_status =
-      vsldConvNewTask1D(&conv_task, VSL_CONV_MODE_DIRECT, input_x.size(),
-                        input_y.size(), response.size());
 
-  // Check if convolution construction was successful
-  if (conv_status != VSL_STATUS_OK) {
+namespace {
+// Implementations shared by the single and double precision overloads below
+template <typename T>
+bool convolve_1d_impl(const std::vector<T>& input_x,
+                      const std::vector<T>& input_y, std::vector<T>& response,
+                      ConvolutionMode mode) {
+  if (input_x.empty() || input_y.empty()) {
     throw std::runtime_error(
-        "\nERROR: in numeric_utils::convolve_1d: Error in convolution "
-        "construction\n");
-    status = false;
+        "\nERROR: in numeric_utils::convolve_1d: Inputs must contain at least "
+        "one value\n");
+  }
+
+  const std::vector<T>& shorter =
+      input_x.size() <= input_y.size() ? input_x : input_y;
+  const std::vector<T>& longer =
+      input_x.size() <= input_y.size() ? input_y : input_x;
+
+  // Direct convolution requires roughly one multiply-add per pair of samples
+  // while FFT convolution requires three transforms of the padded length.
+  // Short kernels always favor direct summation.
+  if (mode == ConvolutionMode::Auto) {
+    double fft_length = static_cast<double>(
+        next_fast_fft_length(input_x.size() + input_y.size() - 1));
+    double direct_cost = static_cast<double>(input_x.size()) *
+                         static_cast<double>(input_y.size());
+    double fft_cost = 3.0 * 2.5 * fft_length * std::log2(fft_length) +
+                      4.0 * fft_length;
+    mode = shorter.size() <= 32 || direct_cost <= fft_cost
+               ? ConvolutionMode::Direct
+               : ConvolutionMode::Fft;
+  }
+
+  if (mode == ConvolutionMode::Fft) {
+    // Single block covering entire longer input
+    BasicConvolutionKernel<T> kernel(shorter, longer.size());
+    return kernel.convolve(longer, response);
   }
 
-  // Set convolution to start at first element in input_y
-  vslConvSetStart(conv_task, 0);
+  response.resize(input_x.size() + input_y.size() - 1);
 
-  // Execute convolution
-  conv_status = vsldConvExec1D(conv_task, input_x.data(), 1, input_y.data(), 1,
-                               response.data(), 1);
+  // Direct summation is provided by the selected backend
+  fft_backend()->convolve(input_x.data(), input_x.size(), input_y.data(),
+                          input_y.size(), response.data());
 
-  // Check if convolution exectution was successful
-  if (conv_status != VSL_STATUS_OK) {
+  return true;
+}
+
+template <typename T>
+bool convolve_1d_overlap_add_impl(const std::vector<T>& input_x,
+                                  const std::vector<T>& input_y,
+                                  std::vector<T>& response,
+                                  std::size_t block_size) {
+  if (input_x.empty() || input_y.empty()) {
     throw std::runtime_error(
-        "\nERROR: in numeric_utils::convolve_1d: Error in convolution "
-        "execution\n");
-    status = false;
+        "\nERROR: in numeric_utils::convolve_1d_overlap_add: Inputs must "
+        "contain at least one value\n");
   }
 
-  // Delete convolution task
-  vslConvDeleteTask(&conv_task);
+  // Use shorter input as kernel and stream longer input through in blocks
+  if (input_x.size() <= input_y.size()) {
+    BasicConvolutionKernel<T> kernel(input_x, block_size);
+    return kernel.convolve(input_y, response);
+  } else {
+    BasicConvolutionKernel<T> kernel(input_y, block_size);
+    return kernel.convolve(input_x, response);
+  }
+}
+
+template <typename T>
+bool fft_r2c_impl(const T* input, std::complex<T>* output,
+                  std::size_t length) {
+  // Get committed plan from cache, creating it on first use of this length
+  auto fft_plan = FftPlanCache::instance()->plan(
+      length, FftDirection::Forward, FftDomain::Real, FftPrecisionOf<T>::value);
+
+  // Compute the forward FFT directly into caller-owned storage
+  fft_plan->execute(input, output);
 
-  return status;
+  return true;
 }
 
-bool inverse_fft(std::vector<std::complex<double>> input_vector,
-                 std::vector<double>& output_vector) {
-  output_vector.resize(input_vector.size());
+template <typename T>
+bool inverse_fft_c2r_impl(const std::complex<T>* input, T* output,
+                          std::size_t length) {
+  // Get committed plan from cache, creating it on first use of this length
+  auto fft_plan =
+      FftPlanCache::instance()->plan(length, FftDirection::Backward,
+                                     FftDomain::Real, FftPrecisionOf<T>::value);
 
-  // Create task descriptor and MKL status
-  DFTI_DESCRIPTOR_HANDLE fft_descriptor;
-  MKL_LONG fft_status;
+  // Compute the backward FFT directly into caller-owned storage
+  fft_plan->execute(input, output);
 
-  // Allocate the descriptor data structure and initializes it with default
-  // configuration values
-  fft_status = DftiCreateDescriptor(&fft_descriptor, DFTI_DOUBLE, DFTI_REAL, 1,
-                                input_vector.size());
-  if (fft_status != DFTI_NO_ERROR) {
-    throw std::runtime_error(
-        "\nERROR: in numeric_utils::inverse_fft: Error in descriptor creation\n");
-    return false;
-  }
-  
-  // Set configuration value to not do inplace transformation
-  fft_status = DftiSetValue(fft_descriptor, DFTI_PLACEMENT, DFTI_NOT_INPLACE);
-  if (fft_status != DFTI_NO_ERROR) {
-    throw std::runtime_error(
-        "\nERROR: in numeric_utils::inverse_fft: Error in setting configuration\n");
-    return false;
-  }
+  return true;
+}
 
-  // Set the backward scale factor to be 1 divided by the size of the input vector
-  // to make the backward tranform the inverse of the forward transform
-  fft_status = DftiSetValue(fft_descriptor, DFTI_BACKWARD_SCALE,
-                            static_cast<double>(1.0 / input_vector.size()));
-  if (fft_status != DFTI_NO_ERROR) {
-    throw std::runtime_error(
-        "\nERROR: in numeric_utils::inverse_fft: Error in setting backward "
-        "scale factor\n");
-    return false;
-  }  
+template <typename T>
+bool fft_r2c_batch_impl(const T* input, std::complex<T>* output,
+                        std::size_t length, const FftLayout& layout) {
+  // Get committed plan from cache, creating it on first use of this shape
+  auto fft_plan = FftPlanCache::instance()->plan(
+      length, FftDirection::Forward, FftDomain::Real, layout,
+      FftPrecisionOf<T>::value);
 
-  // Perform all initialization for the actual FFT computation
-  fft_status = DftiCommitDescriptor(fft_descriptor);
-  if (fft_status != DFTI_NO_ERROR) {
-    throw std::runtime_error(
-        "\nERROR: in numeric_utils::inverse_fft: Error in committing descriptor\n");
-    return false;
-  }
-  
-  // Compute the backward FFT
-  fft_status = DftiComputeBackward(fft_descriptor, input_vector.data(),
-                                   output_vector.data());
-  if (fft_status != DFTI_NO_ERROR) {
+  // Compute all forward FFTs in single call
+  fft_plan->execute(input, output);
+
+  return true;
+}
+
+template <typename T>
+bool fft_r2c_batch_impl(
+    const Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& input_matrix,
+    Eigen::Matrix<std::complex<T>, Eigen::Dynamic, Eigen::Dynamic>&
+        output_matrix) {
+  output_matrix.resize(input_matrix.rows() / 2 + 1, input_matrix.cols());
+
+  // Columns are contiguous, so each signal has unit stride
+  return fft_r2c_batch_impl(
+      input_matrix.data(), output_matrix.data(), input_matrix.rows(),
+      FftLayout(input_matrix.cols(), 1, input_matrix.rows(), 1,
+                output_matrix.rows()));
+}
+
+template <typename T>
+bool inverse_fft_c2r_batch_impl(const std::complex<T>* input, T* output,
+                                std::size_t length, const FftLayout& layout) {
+  // Get committed plan from cache, creating it on first use of this shape
+  auto fft_plan = FftPlanCache::instance()->plan(
+      length, FftDirection::Backward, FftDomain::Real, layout,
+      FftPrecisionOf<T>::value);
+
+  // Compute all backward FFTs in single call
+  fft_plan->execute(input, output);
+
+  return true;
+}
+
+template <typename T>
+bool inverse_fft_c2r_batch_impl(
+    const Eigen::Matrix<std::complex<T>, Eigen::Dynamic, Eigen::Dynamic>&
+        input_matrix,
+    Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>& output_matrix,
+    std::size_t length) {
+  if (static_cast<std::size_t>(input_matrix.rows()) < length / 2 + 1) {
     throw std::runtime_error(
-        "\nERROR: in numeric_utils::inverse_fft: Error in computing backward FFT\n");
-    return false;
+        "\nERROR: in numeric_utils::inverse_fft_c2r_batch: Input half spectra "
+        "are too short for requested output length\n");
   }
-  
-  // Free the memory allocated for descriptor
-  fft_status = DftiFreeDescriptor(&fft_descriptor);
-  if (fft_status != DFTI_NO_ERROR) {
-    throw std::runtime_error(
-        "\nERROR: in numeric_utils::inverse_fft: Error in freeing FFT descriptor\n");
-    return false;
-  }  
+
+  output_matrix.resize(length, input_matrix.cols());
+
+  return inverse_fft_c2r_batch_impl(
+      input_matrix.data(), output_matrix.data(), length,
+      FftLayout(input_matrix.cols(), 1, input_matrix.rows(), 1, length));
+}
+
+// Number of records whose running sums are updated together by the
+// cumulative integration kernels
+const std::size_t kRecordBlockSize = 8;
+
+// Factor by which truncated sampling oversamples the expected number of
+// candidates needed, and limits on the number of candidates per block
+const double kTruncatedOversampling = 1.2;
+const double kMinTruncatedBlock = 16.0;
+const double kMaxTruncatedBlock = 65536.0;
+
+// Number of realizations per block when estimating acceptance probabilities,
+// and limits on the number of accepted and drawn realizations
+const unsigned int kAcceptanceBlock = 4096;
+const std::size_t kMinAcceptedRealizations = 400;
+const std::size_t kMaxAcceptanceSamples = 65536;
+
+double trapazoid_rule(const double* input, std::size_t length,
+                      double spacing) {
+  Eigen::Map<const Eigen::VectorXd> values(input, length);
+  double interior = length > 2 ? values.segment(1, length - 2).sum() : 0.0;
+
+  return ((values(0) + values(length - 1)) / 2.0 + interior) * spacing;
+}
+}  // namespace
+
+bool convolve_1d(const std::vector<double>& input_x,
+                 const std::vector<double>& input_y,
+                 std::vector<double>& response, ConvolutionMode mode) {
+  return convolve_1d_impl(input_x, input_y, response, mode);
+}
+
+bool convolve_1d(const std::vector<float>& input_x,
+                 const std::vector<float>& input_y,
+                 std::vector<float>& response, ConvolutionMode mode) {
+  return convolve_1d_impl(input_x, input_y, response, mode);
+}
+
+bool convolve_1d_overlap_add(const std::vector<double>& input_x,
+                             const std::vector<double>& input_y,
+                             std::vector<double>& response,
+                             std::size_t block_size) {
+  return convolve_1d_overlap_add_impl(input_x, input_y, response, block_size);
+}
+
+bool convolve_1d_overlap_add(const std::vector<float>& input_x,
+                             const std::vector<float>& input_y,
+                             std::vector<float>& response,
+                             std::size_t block_size) {
+  return convolve_1d_overlap_add_impl(input_x, input_y, response, block_size);
+}
+
+bool inverse_fft(const std::complex<double>* input, double* output,
+                 std::size_t length) {
+  // Get committed plan from cache, creating it on first use of this length
+  auto fft_plan = FftPlanCache::instance()->plan(length, FftDirection::Backward,
+                                                 FftDomain::Real);
+
+  // Compute the backward FFT directly into caller-owned storage
+  fft_plan->execute(input, output);
 
   return true;
 }
 
-bool inverse_fft(const Eigen::VectorXcd& input_vector,
+bool inverse_fft(const std::vector<std::complex<double>>& input_vector,
+                 std::vector<double>& output_vector) {
+  output_vector.resize(input_vector.size());
+
+  return inverse_fft(input_vector.data(), output_vector.data(),
+                     input_vector.size());
+}
+
+bool inverse_fft(const Eigen::Ref<const Eigen::VectorXcd>& input_vector,
                  Eigen::VectorXd& output_vector) {
-  // Convert input Eigen vector to std vector
-  std::vector<std::complex<double>> input_vals(input_vector.size());
-  std::vector<double> outputs(input_vals.size());
-  Eigen::VectorXcd::Map(&input_vals[0], input_vector.size()) = input_vector;
- 
+  output_vector.resize(input_vector.size());
+
   try {
-    inverse_fft(input_vals, outputs);
+    inverse_fft(input_vector.data(), output_vector.data(),
+                input_vector.size());
   } catch (const std::exception& e) {
     std::cerr << "\nERROR: In numeric_utils::inverse_fft (With Eigen Vectors):"
               << e.what() << std::endl;
   }
 
-  // Convert output from std vector to Eigen vector
-  output_vector = Eigen::Map<Eigen::VectorXd>(outputs.data(), outputs.size());
-
   return true;
 }
 
-bool inverse_fft(const Eigen::VectorXcd& input_vector,
+bool inverse_fft(const Eigen::Ref<const Eigen::VectorXcd>& input_vector,
                  std::vector<double>& output_vector) {
-  // Convert input Eigen vector to std vector
-  std::vector<std::complex<double>> input_vals(input_vector.size());
-  Eigen::VectorXcd::Map(&input_vals[0], input_vector.size()) = input_vector;
-  output_vector.resize(input_vector.size());  
- 
+  output_vector.resize(input_vector.size());
+
   try {
-    inverse_fft(input_vals, output_vector);
+    inverse_fft(input_vector.data(), output_vector.data(),
+                input_vector.size());
   } catch (const std::exception& e) {
     std::cerr << "\nERROR: In numeric_utils::inverse_fft (With Eigen Vectors):"
               << e.what() << std::endl;
   }
 
-  return true;  
+  return true;
 }
 
-bool fft(std::vector<double> input_vector,
-         std::vector<std::complex<double>>& output_vector) {
-  // Convert input vector to complex values
-  std::vector<std::complex<double>> input_complex(input_vector.size());
-  std::copy(input_vector.begin(), input_vector.end(), input_complex.begin());
-  
-  output_vector.resize(input_vector.size());
-
-  // Create task descriptor and MKL status
-  DFTI_DESCRIPTOR_HANDLE fft_descriptor;
-  MKL_LONG fft_status;
+bool fft(const double* input, std::complex<double>* output,
+         std::size_t length) {
+  // Compute non-redundant half of spectrum using real-to-complex transform
+  fft_r2c(input, output, length);
 
-  // Allocate the descriptor data structure and initializes it with default
-  // configuration values
-  fft_status = DftiCreateDescriptor(&fft_descriptor, DFTI_DOUBLE, DFTI_COMPLEX,
-                                    1, input_complex.size());
-  if (fft_status != DFTI_NO_ERROR) {
-    throw std::runtime_error(
-        "\nERROR: in numeric_utils::fft: Error in descriptor creation\n");
-    return false;
-  }
-  
-  // Set configuration value to not do inplace transformation
-  fft_status = DftiSetValue(fft_descriptor, DFTI_PLACEMENT, DFTI_NOT_INPLACE);
-  if (fft_status != DFTI_NO_ERROR) {
-    throw std::runtime_error(
-        "\nERROR: in numeric_utils::fft: Error in setting configuration\n");
-    return false;
+  // Fill remainder of spectrum using conjugate symmetry of real input
+  for (std::size_t i = length / 2 + 1; i < length; ++i) {
+    output[i] = std::conj(output[length - i]);
   }
 
-  // Perform all initialization for the actual FFT computation
-  fft_status = DftiCommitDescriptor(fft_descriptor);
-  if (fft_status != DFTI_NO_ERROR) {
-    throw std::runtime_error(
-        "\nERROR: in numeric_utils::fft: Error in committing descriptor\n");
-    return false;
-  }
-  
-  // Compute the backward FFT
-  fft_status = DftiComputeForward(fft_descriptor, input_complex.data(),
-                                  output_vector.data());
-  if (fft_status != DFTI_NO_ERROR) {
-    throw std::runtime_error(
-        "\nERROR: in numeric_utils::fft: Error in computing FFT\n");
-    return false;
-  }
-  
-  // Free the memory allocated for descriptor
-  fft_status = DftiFreeDescriptor(&fft_descriptor);
-  if (fft_status != DFTI_NO_ERROR) {
-    throw std::runtime_error(
-        "\nERROR: in numeric_utils::fft: Error in freeing FFT descriptor\n");
-    return false;
-  }  
-
   return true;
 }
 
-bool fft(const Eigen::VectorXd& input_vector, Eigen::VectorXcd& output_vector) {
-  // Convert input Eigen vector to std vector
-  std::vector<double> input_vals(input_vector.size());
-  std::vector<std::complex<double>> outputs(input_vals.size());
-  Eigen::VectorXd::Map(&input_vals[0], input_vector.size()) = input_vector;
- 
+bool fft(const std::vector<double>& input_vector,
+         std::vector<std::complex<double>>& output_vector) {
+  output_vector.resize(input_vector.size());
+
+  return fft(input_vector.data(), output_vector.data(), input_vector.size());
+}
+
+bool fft(const Eigen::Ref<const Eigen::VectorXd>& input_vector,
+         Eigen::VectorXcd& output_vector) {
+  output_vector.resize(input_vector.size());
+
   try {
-    fft(input_vals, outputs);
+    fft(input_vector.data(), output_vector.data(), input_vector.size());
   } catch (const std::exception& e) {
     std::cerr << "\nERROR: In numeric_utils::fft (With Eigen Vectors):"
               << e.what() << std::endl;
   }
 
-  // Convert output from std vector to Eigen vector
-  output_vector = Eigen::Map<Eigen::VectorXcd>(outputs.data(), outputs.size());
-
   return true;
 }
 
-bool fft(const Eigen::VectorXd& input_vector,
-                 std::vector<std::complex<double>>& output_vector) {
-  // Convert input Eigen vector to std vector
-  std::vector<double> input_vals(input_vector.size());
-  Eigen::VectorXd::Map(&input_vals[0], input_vector.size()) = input_vector;
-  output_vector.resize(input_vector.size());  
- 
+bool fft(const Eigen::Ref<const Eigen::VectorXd>& input_vector,
+         std::vector<std::complex<double>>& output_vector) {
+  output_vector.resize(input_vector.size());
+
   try {
-    fft(input_vals, output_vector);
+    fft(input_vector.data(), output_vector.data(), input_vector.size());
   } catch (const std::exception& e) {
     std::cerr << "\nERROR: In numeric_utils::fft (With Eigen Vector and STL vector):"
               << e.what() << std::endl;
   }
 
-  return true;  
-}  
-  
-double trapazoid_rule(const std::vector<double>& input_vector, double spacing) {
-  double result = (input_vector[0] + input_vector[input_vector.size() - 1]) / 2.0;
+  return true;
+}
+
+bool fft_r2c(const double* input, std::complex<double>* output,
+             std::size_t length) {
+  return fft_r2c_impl(input, output, length);
+}
+
+bool fft_r2c(const float* input, std::complex<float>* output,
+             std::size_t length) {
+  return fft_r2c_impl(input, output, length);
+}
+
+bool fft_r2c(const std::vector<double>& input_vector,
+             std::vector<std::complex<double>>& output_vector) {
+  output_vector.resize(input_vector.size() / 2 + 1);
+
+  return fft_r2c(input_vector.data(), output_vector.data(),
+                 input_vector.size());
+}
+
+bool fft_r2c(const Eigen::Ref<const Eigen::VectorXd>& input_vector,
+             Eigen::VectorXcd& output_vector) {
+  output_vector.resize(input_vector.size() / 2 + 1);
+
+  return fft_r2c(input_vector.data(), output_vector.data(),
+                 input_vector.size());
+}
+
+bool fft_r2c(const Eigen::Ref<const Eigen::VectorXd>& input_vector,
+             std::vector<std::complex<double>>& output_vector) {
+  output_vector.resize(input_vector.size() / 2 + 1);
+
+  return fft_r2c(input_vector.data(), output_vector.data(),
+                 input_vector.size());
+}
+
+bool fft_r2c_inplace(double* data, std::size_t length) {
+  // Get committed in-place plan from cache, creating it on first use
+  auto fft_plan = FftPlanCache::instance()->plan(
+      length, FftDirection::Forward, FftDomain::Real,
+      FftLayout(1, 1, 0, 1, 0, true));
+
+  // Half spectrum overwrites the padded input buffer
+  fft_plan->execute(data);
+
+  return true;
+}
+
+bool inverse_fft_c2r(const std::complex<double>* input, double* output,
+                     std::size_t length) {
+  return inverse_fft_c2r_impl(input, output, length);
+}
+
+bool inverse_fft_c2r(const std::complex<float>* input, float* output,
+                     std::size_t length) {
+  return inverse_fft_c2r_impl(input, output, length);
+}
+
+bool inverse_fft_c2r(const std::vector<std::complex<double>>& input_vector,
+                     std::vector<double>& output_vector, std::size_t length) {
+  if (input_vector.size() < length / 2 + 1) {
+    throw std::runtime_error(
+        "\nERROR: in numeric_utils::inverse_fft_c2r: Input half spectrum is "
+        "too short for requested output length\n");
+  }
+
+  output_vector.resize(length);
+
+  return inverse_fft_c2r(input_vector.data(), output_vector.data(), length);
+}
 
-  for (unsigned int i = 1; i < input_vector.size() - 1; ++i) {
-    result = result + input_vector[i];
+bool inverse_fft_c2r(const Eigen::Ref<const Eigen::VectorXcd>& input_vector,
+                     std::vector<double>& output_vector, std::size_t length) {
+  if (static_cast<std::size_t>(input_vector.size()) < length / 2 + 1) {
+    throw std::runtime_error(
+        "\nERROR: in numeric_utils::inverse_fft_c2r: Input half spectrum is "
+        "too short for requested output length\n");
   }
 
-  return result * spacing;
+  output_vector.resize(length);
+
+  return inverse_fft_c2r(input_vector.data(), output_vector.data(), length);
+}
+
+bool inverse_fft_c2r_inplace(std::complex<double>* data, std::size_t length) {
+  // Get committed in-place plan from cache, creating it on first use
+  auto fft_plan = FftPlanCache::instance()->plan(
+      length, FftDirection::Backward, FftDomain::Real,
+      FftLayout(1, 1, 0, 1, 0, true));
+
+  // Real output overwrites the start of the half spectrum buffer
+  fft_plan->execute(data);
+
+  return true;
+}
+
+bool fft_r2c_batch(const Eigen::MatrixXd& input_matrix,
+                   Eigen::MatrixXcd& output_matrix) {
+  return fft_r2c_batch_impl(input_matrix, output_matrix);
+}
+
+bool fft_r2c_batch(const Eigen::MatrixXf& input_matrix,
+                   Eigen::MatrixXcf& output_matrix) {
+  return fft_r2c_batch_impl(input_matrix, output_matrix);
+}
+
+bool fft_r2c_batch(const double* input, std::complex<double>* output,
+                   std::size_t length, const FftLayout& layout) {
+  return fft_r2c_batch_impl(input, output, length, layout);
+}
+
+bool fft_r2c_batch(const float* input, std::complex<float>* output,
+                   std::size_t length, const FftLayout& layout) {
+  return fft_r2c_batch_impl(input, output, length, layout);
+}
+
+bool inverse_fft_c2r_batch(const Eigen::MatrixXcd& input_matrix,
+                           Eigen::MatrixXd& output_matrix, std::size_t length) {
+  return inverse_fft_c2r_batch_impl(input_matrix, output_matrix, length);
+}
+
+bool inverse_fft_c2r_batch(const Eigen::MatrixXcf& input_matrix,
+                           Eigen::MatrixXf& output_matrix, std::size_t length) {
+  return inverse_fft_c2r_batch_impl(input_matrix, output_matrix, length);
+}
+
+bool inverse_fft_c2r_batch(const std::complex<double>* input, double* output,
+                           std::size_t length, const FftLayout& layout) {
+  return inverse_fft_c2r_batch_impl(input, output, length, layout);
+}
+
+bool inverse_fft_c2r_batch(const std::complex<float>* input, float* output,
+                           std::size_t length, const FftLayout& layout) {
+  return inverse_fft_c2r_batch_impl(input, output, length, layout);
+}
+
+double trapazoid_rule(const std::vector<double>& input_vector, double spacing) {
+  return trapazoid_rule(input_vector.data(), input_vector.size(), spacing);
 }
 
 double trapazoid_rule(const Eigen::VectorXd& input_vector, double spacing) {
-  double result = (input_vector[0] + input_vector[input_vector.size() - 1]) / 2.0;
+  return trapazoid_rule(input_vector.data(), input_vector.size(), spacing);
+}
 
-  for (unsigned int i = 1; i < input_vector.size() - 1; ++i) {
-    result = result + input_vector[i];
+void cumulative_trapezoid(const double* input, double* output,
+                          std::size_t length, std::size_t num_records,
+                          double spacing) {
+  double half_spacing = 0.5 * spacing;
+
+  for (std::size_t first = 0; first < num_records; first += kRecordBlockSize) {
+    std::size_t block = std::min(kRecordBlockSize, num_records - first);
+    const double* block_input = input + first * length;
+    double* block_output = output + first * length;
+    double running[kRecordBlockSize] = {};
+    double previous[kRecordBlockSize] = {};
+
+    for (std::size_t i = 0; i < length; ++i) {
+      for (std::size_t j = 0; j < block; ++j) {
+        double value = block_input[j * length + i];
+        if (i > 0) {
+          running[j] += half_spacing * (previous[j] + value);
+        }
+        previous[j] = value;
+        block_output[j * length + i] = running[j];
+      }
+    }
   }
+}
+
+void cumulative_trapezoid(Eigen::MatrixXd& records, double spacing) {
+  cumulative_trapezoid(records.data(), records.data(), records.rows(),
+                       records.cols(), spacing);
+}
 
-  return result * spacing;
+void cumulative_double_integral(const double* input, double* first_integral,
+                                double* second_integral, std::size_t length,
+                                std::size_t num_records, double spacing,
+                                double scale) {
+  for (std::size_t first = 0; first < num_records; first += kRecordBlockSize) {
+    std::size_t block = std::min(kRecordBlockSize, num_records - first);
+    std::size_t offset = first * length;
+    double first_running[kRecordBlockSize] = {};
+    double second_running[kRecordBlockSize] = {};
+
+    for (std::size_t i = 0; i < length; ++i) {
+      for (std::size_t j = 0; j < block; ++j) {
+        std::size_t index = offset + j * length + i;
+        first_running[j] += input[index] * scale * spacing;
+        second_running[j] += first_running[j] * spacing;
+        if (first_integral) {
+          first_integral[index] = first_running[j];
+        }
+        second_integral[index] = second_running[j];
+      }
+    }
+  }
+}
+
+void cumulative_double_integral(Eigen::MatrixXd& records, double spacing,
+                                double scale) {
+  cumulative_double_integral(records.data(), nullptr, records.data(),
+                             records.rows(), records.cols(), spacing, scale);
+}
+
+void cumulative_energy(const double* input, double* output, std::size_t length,
+                       std::size_t num_records, double scale) {
+  for (std::size_t first = 0; first < num_records; first += kRecordBlockSize) {
+    std::size_t block = std::min(kRecordBlockSize, num_records - first);
+    std::size_t offset = first * length;
+    double running[kRecordBlockSize] = {};
+
+    for (std::size_t i = 0; i < length; ++i) {
+      for (std::size_t j = 0; j < block; ++j) {
+        std::size_t index = offset + j * length + i;
+        running[j] += input[index] * input[index] * scale;
+        output[index] = running[j];
+      }
+    }
+  }
+}
+
+void cumulative_energy(Eigen::MatrixXd& records, double scale) {
+  cumulative_energy(records.data(), records.data(), records.rows(),
+                    records.cols(), scale);
+}
+
+double arias_intensity(const std::vector<double>& acceleration,
+                       double time_step, double gravity) {
+  double sum_squares = 0.0;
+  for (auto const& value : acceleration) {
+    sum_squares += value * value;
+  }
+
+  return M_PI / (2.0 * gravity) * time_step * sum_squares;
+}
+
+Eigen::VectorXd periodogram(const std::vector<double>& time_history,
+                            double time_step,
+                            const Eigen::VectorXd& frequencies) {
+  Eigen::VectorXd density = Eigen::VectorXd::Zero(frequencies.size());
+  if (time_history.empty()) {
+    return density;
+  }
+
+  for (Eigen::Index k = 0; k < frequencies.size(); ++k) {
+    // Advance phasor by rotation instead of evaluating sine and cosine at
+    // every sample
+    const std::complex<double> rotation =
+        std::polar(1.0, -frequencies(k) * time_step);
+    std::complex<double> phasor(1.0, 0.0), transform(0.0, 0.0);
+    for (auto const& value : time_history) {
+      transform += value * phasor;
+      phasor *= rotation;
+    }
+    density(k) = 2.0 * time_step / static_cast<double>(time_history.size()) *
+                 std::norm(transform);
+  }
+
+  return density;
+}
+
+std::vector<std::size_t> threshold_crossings(
+    const double* values, std::size_t length,
+    const std::vector<double>& thresholds, bool relative) {
+  std::vector<std::size_t> crossings(thresholds.size(), length);
+  if (length == 0 || thresholds.empty()) {
+    return crossings;
+  }
+
+  // Visit thresholds in ascending order, since a record must reach lower
+  // thresholds no later than higher ones
+  std::vector<std::size_t> order(thresholds.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(),
+            [&thresholds](std::size_t lhs, std::size_t rhs) {
+              return thresholds[lhs] < thresholds[rhs];
+            });
+
+  double reference = relative ? values[length - 1] : 1.0;
+  std::size_t next = 0;
+  for (std::size_t i = 0; i < length && next < order.size(); ++i) {
+    while (next < order.size() &&
+           values[i] >= thresholds[order[next]] * reference) {
+      crossings[order[next]] = i;
+      ++next;
+    }
+  }
+
+  return crossings;
+}
+
+Eigen::Matrix<std::size_t, Eigen::Dynamic, Eigen::Dynamic> threshold_crossings(
+    const Eigen::MatrixXd& records, const std::vector<double>& thresholds,
+    bool relative) {
+  Eigen::Matrix<std::size_t, Eigen::Dynamic, Eigen::Dynamic> crossings(
+      thresholds.size(), records.cols());
+
+  for (Eigen::Index i = 0; i < records.cols(); ++i) {
+    auto record_crossings = threshold_crossings(
+        records.col(i).data(), records.rows(), thresholds, relative);
+    for (std::size_t j = 0; j < thresholds.size(); ++j) {
+      crossings(j, i) = record_crossings[j];
+    }
+  }
+
+  return crossings;
 }
 
 Eigen::VectorXd polyfit_intercept(const Eigen::VectorXd& points,
@@ -343,43 +697,300 @@ std::vector<double> derivative(const std::vector<double>& coefficients,
 
 Eigen::VectorXd evaluate_polynomial(const Eigen::VectorXd& coefficients,
                                     const Eigen::VectorXd& points) {
-  Eigen::VectorXd evaluations = Eigen::VectorXd::Zero(points.size());
-
-  for (unsigned int i = 0; i < evaluations.size(); ++i) {
-    for (unsigned int j = 0; j < coefficients.size(); ++j) {
-      evaluations(i) +=
-          coefficients(j) * std::pow(points(i), coefficients.size() - 1 - j);
-    }
-  }
+  Eigen::VectorXd evaluations(points.size());
+  evaluate_polynomial(coefficients.data(), coefficients.size(), points.data(),
+                      evaluations.data(), points.size());
 
   return evaluations;
 }
 
 Eigen::VectorXd evaluate_polynomial(const Eigen::VectorXd& coefficients,
                                     const std::vector<double>& points) {
-  Eigen::VectorXd evaluations = Eigen::VectorXd::Zero(points.size());
+  Eigen::VectorXd evaluations(points.size());
+  evaluate_polynomial(coefficients.data(), coefficients.size(), points.data(),
+                      evaluations.data(), points.size());
+
+  return evaluations;
+}
+
+std::vector<double> evaluate_polynomial(const std::vector<double>& coefficients,
+                                        const std::vector<double>& points) {
+  std::vector<double> evaluations(points.size());
+  evaluate_polynomial(coefficients.data(), coefficients.size(), points.data(),
+                      evaluations.data(), points.size());
+
+  return evaluations;
+}
+
+void evaluate_polynomial(const double* coefficients,
+                         std::size_t num_coefficients, const double* points,
+                         double* evaluations, std::size_t num_points) {
+  Eigen::Map<const Eigen::ArrayXd> point_values(points, num_points);
+  Eigen::Map<Eigen::ArrayXd> values(evaluations, num_points);
 
-  for (unsigned int i = 0; i < evaluations.size(); ++i) {
-    for (unsigned int j = 0; j < coefficients.size(); ++j) {
-      evaluations(i) +=
-          coefficients(j) * std::pow(points[i], coefficients.size() - 1 - j);
+  if (num_coefficients == 0) {
+    values.setZero();
+    return;
+  }
+
+  // Horner's scheme with the loop over points innermost so that each step is
+  // a vectorized multiply-add over the whole grid
+  values.setConstant(coefficients[0]);
+  for (std::size_t j = 1; j < num_coefficients; ++j) {
+    values = values * point_values + coefficients[j];
+  }
+}
+
+Eigen::MatrixXd evaluate_polynomial_derivatives(
+    const Eigen::VectorXd& coefficients, const Eigen::VectorXd& points,
+    unsigned int num_derivatives) {
+  Eigen::MatrixXd evaluations =
+      Eigen::MatrixXd::Zero(points.size(), num_derivatives + 1);
+
+  if (coefficients.size() == 0) {
+    return evaluations;
+  }
+
+  // Extended Horner's scheme: column k accumulates the k-th derivative
+  // divided by k!, which only requires multiply-adds
+  evaluations.col(0).setConstant(coefficients(0));
+  for (Eigen::Index j = 1; j < coefficients.size(); ++j) {
+    for (Eigen::Index k = std::min<Eigen::Index>(num_derivatives, j); k > 0;
+         --k) {
+      evaluations.col(k).array() =
+          evaluations.col(k).array() * points.array() +
+          evaluations.col(k - 1).array();
     }
+    evaluations.col(0).array() =
+        evaluations.col(0).array() * points.array() + coefficients(j);
+  }
+
+  double factorial = 1.0;
+  for (unsigned int k = 2; k <= num_derivatives; ++k) {
+    factorial *= k;
+    evaluations.col(k) *= factorial;
   }
 
   return evaluations;
 }
 
-std::vector<double> evaluate_polynomial(const std::vector<double>& coefficients,
-                                        const std::vector<double>& points) {
-  std::vector<double> evaluations(points.size(), 0.0);
+Eigen::MatrixXd evaluate_polynomial_batch(const Eigen::MatrixXd& coefficients,
+                                          const Eigen::VectorXd& points,
+                                          unsigned int derivative) {
+  Eigen::MatrixXd evaluations =
+      Eigen::MatrixXd::Zero(points.size(), coefficients.cols());
+
+  // Derivatives of order at least the number of terms vanish
+  if (static_cast<Eigen::Index>(derivative) >= coefficients.rows()) {
+    return evaluations;
+  }
 
-  for (unsigned int i = 0; i < evaluations.size(); ++i) {
-    for (unsigned int j = 0; j < coefficients.size(); ++j) {
-      evaluations[i] +=
-          coefficients[j] * std::pow(points[i], coefficients.size() - 1 - j);
+  // Scale coefficients by the falling factorial of their powers to get the
+  // coefficients of the requested derivative
+  Eigen::Index num_terms = coefficients.rows() - derivative;
+  Eigen::MatrixXd derivative_coeffs = coefficients.topRows(num_terms);
+  for (Eigen::Index j = 0; j < num_terms; ++j) {
+    double power = static_cast<double>(coefficients.rows() - 1 - j);
+    double scale = 1.0;
+    for (unsigned int k = 0; k < derivative; ++k) {
+      scale *= power - k;
     }
+    derivative_coeffs.row(j) *= scale;
+  }
+
+  // Horner's scheme applied to all records at once, one contiguous column of
+  // points per record
+  evaluations.rowwise() = derivative_coeffs.row(0);
+  for (Eigen::Index j = 1; j < num_terms; ++j) {
+    evaluations.array().colwise() *= points.array();
+    evaluations.rowwise() += derivative_coeffs.row(j);
   }
 
   return evaluations;
-}  
+}
+
+Eigen::VectorXd control_variate_mean(const Eigen::MatrixXd& samples,
+                                     const Eigen::VectorXd& controls,
+                                     double control_mean) {
+  if (samples.rows() != controls.size() || samples.rows() < 2) {
+    throw std::runtime_error(
+        "\nERROR: In numeric_utils::control_variate_mean: Number of samples "
+        "does not match number of controls or is less than 2\n");
+  }
+
+  Eigen::VectorXd control_deviations = controls.array() - controls.mean();
+  double control_variance = control_deviations.squaredNorm();
+
+  // Controls without spread carry no information about the samples
+  if (control_variance == 0.0) {
+    return samples.colwise().mean().transpose();
+  }
+
+  // Least squares regression coefficient of each statistic on the control
+  Eigen::VectorXd coefficients =
+      samples.transpose() * control_deviations / control_variance;
+
+  return samples.colwise().mean().transpose() -
+         coefficients * (controls.mean() - control_mean);
+}
+
+Eigen::VectorXd normal_likelihood_ratios(const Eigen::MatrixXd& realizations,
+                                         const Eigen::VectorXd& means,
+                                         const Eigen::MatrixXd& cov,
+                                         const Eigen::VectorXd& proposal_means,
+                                         const Eigen::MatrixXd& proposal_cov) {
+  if (realizations.rows() != means.size() ||
+      proposal_means.size() != means.size() || cov.rows() != means.size() ||
+      proposal_cov.rows() != means.size()) {
+    throw std::runtime_error(
+        "\nERROR: In numeric_utils::normal_likelihood_ratios: Dimensions of "
+        "realizations and distributions do not match\n");
+  }
+
+  Eigen::LLT<Eigen::MatrixXd> target_llt(cov), proposal_llt(proposal_cov);
+  if (target_llt.info() == Eigen::NumericalIssue ||
+      proposal_llt.info() == Eigen::NumericalIssue) {
+    throw std::runtime_error(
+        "\nERROR: In numeric_utils::normal_likelihood_ratios: Covariance "
+        "matrix is not positive definite\n");
+  }
+
+  // Log densities up to the normalizing constant shared by both
+  // distributions, using whitened deviations from the mean values
+  auto log_density = [&realizations](const Eigen::LLT<Eigen::MatrixXd>& llt,
+                                     const Eigen::VectorXd& mean) {
+    Eigen::MatrixXd whitened = llt.matrixL().solve(realizations.colwise() - mean);
+    double log_det = llt.matrixLLT().diagonal().array().log().sum();
+    return Eigen::ArrayXd(-0.5 * whitened.colwise().squaredNorm().transpose()
+                              .array() -
+                          log_det);
+  };
+
+  return (log_density(target_llt, means) -
+          log_density(proposal_llt, proposal_means))
+      .exp()
+      .matrix();
+}
+
+double acceptance_ratio(
+    const std::function<Eigen::Array<bool, 1, Eigen::Dynamic>(
+        const Eigen::MatrixXd&)>& accept,
+    const Eigen::VectorXd& means, const Eigen::MatrixXd& cov,
+    const Eigen::VectorXd& proposal_means, const Eigen::MatrixXd& proposal_cov,
+    RandomStream& stream) {
+  if (proposal_means.size() != means.size() || cov.rows() != means.size() ||
+      proposal_cov.rows() != means.size()) {
+    throw std::runtime_error(
+        "\nERROR: In numeric_utils::acceptance_ratio: Dimensions of "
+        "distributions do not match\n");
+  }
+
+  Eigen::LLT<Eigen::MatrixXd> target_llt(cov), proposal_llt(proposal_cov);
+  if (target_llt.info() == Eigen::NumericalIssue ||
+      proposal_llt.info() == Eigen::NumericalIssue) {
+    throw std::runtime_error(
+        "\nERROR: In numeric_utils::acceptance_ratio: Covariance matrix is "
+        "not positive definite\n");
+  }
+  Eigen::MatrixXd target_factor = target_llt.matrixL(),
+                  proposal_factor = proposal_llt.matrixL();
+
+  // Draw both distributions from the same unit normal values, so errors in
+  // the two estimates are positively correlated and partly cancel in ratio
+  Eigen::MatrixXd unit_normals(means.size(), kAcceptanceBlock);
+  Eigen::MatrixXd realizations(means.size(), kAcceptanceBlock);
+  std::size_t num_drawn = 0, target_accepted = 0, proposal_accepted = 0;
+
+  while ((target_accepted < kMinAcceptedRealizations ||
+          proposal_accepted < kMinAcceptedRealizations) &&
+         num_drawn < kMaxAcceptanceSamples) {
+    stream.fill_normal(unit_normals.data(), unit_normals.size());
+
+    realizations.noalias() = target_factor * unit_normals;
+    realizations.colwise() += means;
+    target_accepted += static_cast<std::size_t>(accept(realizations).count());
+
+    realizations.noalias() = proposal_factor * unit_normals;
+    realizations.colwise() += proposal_means;
+    proposal_accepted +=
+        static_cast<std::size_t>(accept(realizations).count());
+
+    num_drawn += kAcceptanceBlock;
+  }
+
+  if (target_accepted == 0 || proposal_accepted == 0) {
+    throw std::runtime_error(
+        "\nERROR: In numeric_utils::acceptance_ratio: No realizations of "
+        "target or proposal distribution were accepted\n");
+  }
+
+  return static_cast<double>(proposal_accepted) /
+         static_cast<double>(target_accepted);
+}
+
+bool RandomGenerator::generate(
+    Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic>& random_numbers,
+    const Eigen::VectorXf& means, const Eigen::MatrixXf& cov,
+    unsigned int cases) {
+  Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic> double_numbers;
+  bool success = generate(double_numbers, means.cast<double>(),
+                          cov.cast<double>(), cases);
+  random_numbers = double_numbers.cast<float>();
+
+  return success;
+}
+
+bool RandomGenerator::prepare(const Eigen::VectorXd& means,
+                              const Eigen::MatrixXd& cov) {
+  prepared_means_ = means;
+  prepared_cov_ = cov;
+
+  return true;
+}
+
+void RandomGenerator::draw(
+    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>& random_numbers,
+    unsigned int cases) {
+  generate(random_numbers, prepared_means_, prepared_cov_, cases);
+}
+
+void RandomGenerator::draw_truncated(
+    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic>& random_numbers,
+    const Eigen::VectorXd& lower, const Eigen::VectorXd& upper,
+    unsigned int cases) {
+  random_numbers.resize(lower.size(), cases);
+
+  Eigen::MatrixXd candidates;
+  std::size_t num_drawn = 0, num_inside = 0;
+  unsigned int accepted = 0;
+
+  while (accepted < cases) {
+    // Oversample remaining cases by inverse of observed acceptance rate,
+    // assuming every candidate is accepted until one block has been drawn
+    double acceptance_rate =
+        num_drawn == 0 ? 1.0
+                       : std::max(static_cast<double>(num_inside), 1.0) /
+                             static_cast<double>(num_drawn);
+    double block_size = std::ceil(kTruncatedOversampling *
+                                  static_cast<double>(cases - accepted) /
+                                  acceptance_rate);
+    draw(candidates, static_cast<unsigned int>(std::min(
+                         std::max(block_size, kMinTruncatedBlock),
+                         kMaxTruncatedBlock)));
+
+    Eigen::Array<bool, 1, Eigen::Dynamic> inside =
+        ((candidates.colwise() - lower).array() >= 0.0).colwise().all() &&
+        (((-candidates).colwise() + upper).array() >= 0.0).colwise().all();
+
+    num_drawn += static_cast<std::size_t>(candidates.cols());
+    num_inside += static_cast<std::size_t>(inside.count());
+
+    for (Eigen::Index i = 0; i < candidates.cols() && accepted < cases; ++i) {
+      if (inside(i)) {
+        random_numbers.col(accepted++) = candidates.col(i);
+      }
+    }
+  }
+}
+
 }  // namespace numeric_utils
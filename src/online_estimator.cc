@@ -0,0 +1,65 @@
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <boost/math/distributions/students_t.hpp>
+#include <Eigen/Dense>
+#include "online_estimator.h"
+
+namespace numeric_utils {
+
+void OnlineEstimator::add(const Eigen::VectorXd& sample) {
+  if (count_ == 0) {
+    mean_ = Eigen::VectorXd::Zero(sample.size());
+    squared_deviations_ = Eigen::VectorXd::Zero(sample.size());
+  } else if (sample.size() != mean_.size()) {
+    throw std::runtime_error(
+        "\nERROR: In numeric_utils::OnlineEstimator::add: Number of statistics "
+        "in sample does not match previous samples\n");
+  }
+
+  ++count_;
+  Eigen::VectorXd deviation = sample - mean_;
+  mean_ += deviation / static_cast<double>(count_);
+  squared_deviations_.array() += deviation.array() * (sample - mean_).array();
+}
+
+Eigen::VectorXd OnlineEstimator::variance() const {
+  if (count_ < 2) {
+    return Eigen::VectorXd::Zero(mean_.size());
+  }
+  return squared_deviations_ / static_cast<double>(count_ - 1);
+}
+
+Eigen::VectorXd OnlineEstimator::half_widths(double confidence) const {
+  if (confidence <= 0.0 || confidence >= 1.0) {
+    throw std::runtime_error(
+        "\nERROR: In numeric_utils::OnlineEstimator::half_widths: Confidence "
+        "level must be between 0 and 1\n");
+  }
+
+  if (count_ < 2) {
+    return Eigen::VectorXd::Constant(mean_.size(),
+                                     std::numeric_limits<double>::infinity());
+  }
+
+  const boost::math::students_t_distribution<double> students_t(
+      static_cast<double>(count_ - 1));
+  double critical_value =
+      boost::math::quantile(students_t, 0.5 * (1.0 + confidence));
+
+  return critical_value *
+         (variance() / static_cast<double>(count_)).cwiseSqrt();
+}
+
+double OnlineEstimator::relative_precision(double confidence) const {
+  if (count_ < 2 || mean_.size() == 0) {
+    return std::numeric_limits<double>::infinity();
+  }
+
+  return (half_widths(confidence).array() / mean_.array().abs()).maxCoeff();
+}
+
+bool OnlineEstimator::converged(double tolerance, double confidence) const {
+  return relative_precision(confidence) <= tolerance;
+}
+}  // namespace numeric_utils
@@ -0,0 +1,96 @@
+#define _USE_MATH_DEFINES
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <utility>
+#include <vector>
+#include "quantile_table.h"
+
+namespace stochastic {
+namespace {
+// Tabulated range of standard normal values, [-kTableRange, kTableRange],
+// which contains all but about 2e-9 of the probability
+const double kTableRange = 6.0;
+// Numbers of segments tried when building tables
+const std::size_t kMinSegments = 64;
+const std::size_t kMaxSegments = 4096;
+}  // namespace
+
+QuantileTable::QuantileTable(std::function<double(double)> transform,
+                             const std::function<double(double)>& density,
+                             double tolerance)
+    : transform_{std::move(transform)},
+      inv_step_{0.0},
+      valid_{false} {
+  for (std::size_t num_segments = kMinSegments;
+       num_segments <= kMaxSegments && !valid_; num_segments *= 2) {
+    valid_ = tabulate(density, num_segments, tolerance);
+  }
+}
+
+double QuantileTable::evaluate(double value) const {
+  double position = (value + kTableRange) * inv_step_;
+
+  // Negated comparison also sends NaN values to exact transformation
+  if (!(position >= 0.0 && position < static_cast<double>(num_segments()))) {
+    return transform_(value);
+  }
+
+  auto segment = static_cast<std::size_t>(position);
+  double local = position - static_cast<double>(segment);
+  const double* coefficients = &coefficients_[4 * segment];
+
+  return coefficients[0] +
+         local * (coefficients[1] +
+                  local * (coefficients[2] + local * coefficients[3]));
+}
+
+void QuantileTable::transform(ValuesRef values) const {
+  values = values.unaryExpr([this](double value) { return evaluate(value); });
+}
+
+bool QuantileTable::tabulate(const std::function<double(double)>& density,
+                             std::size_t num_segments, double tolerance) {
+  double step = 2.0 * kTableRange / static_cast<double>(num_segments);
+  inv_step_ = 1.0 / step;
+
+  // Slope of transformation is ratio of standard normal density to density
+  // of distribution at transformed value, scaled to unit segment length
+  std::vector<double> nodes(num_segments + 1), slopes(num_segments + 1);
+  for (std::size_t i = 0; i <= num_segments; ++i) {
+    double location = -kTableRange + static_cast<double>(i) * step;
+    nodes[i] = transform_(location);
+    slopes[i] = step * std::exp(-0.5 * location * location) /
+                (std::sqrt(2.0 * M_PI) * density(nodes[i]));
+
+    if (!std::isfinite(nodes[i]) || !std::isfinite(slopes[i])) {
+      return false;
+    }
+  }
+
+  coefficients_.resize(4 * num_segments);
+  for (std::size_t i = 0; i < num_segments; ++i) {
+    double difference = nodes[i + 1] - nodes[i];
+    coefficients_[4 * i] = nodes[i];
+    coefficients_[4 * i + 1] = slopes[i];
+    coefficients_[4 * i + 2] =
+        3.0 * difference - 2.0 * slopes[i] - slopes[i + 1];
+    coefficients_[4 * i + 3] = slopes[i] + slopes[i + 1] - 2.0 * difference;
+  }
+
+  // Check interpolation error at points between nodes
+  for (std::size_t i = 0; i < num_segments; ++i) {
+    for (double fraction : {0.25, 0.5, 0.75}) {
+      double location =
+          -kTableRange + (static_cast<double>(i) + fraction) * step;
+      double exact = transform_(location);
+      if (!(std::abs(evaluate(location) - exact) <=
+            tolerance * std::max(1.0, std::abs(exact)))) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+}  // namespace stochastic
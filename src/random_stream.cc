@@ -0,0 +1,135 @@
+#define _USE_MATH_DEFINES
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <Eigen/Dense>
+#include "random_stream.h"
+
+namespace numeric_utils {
+namespace {
+// Philox4x32 round multipliers and Weyl sequence key increments
+const std::uint32_t kPhiloxMultiplier0 = 0xD2511F53;
+const std::uint32_t kPhiloxMultiplier1 = 0xCD9E8D57;
+const std::uint32_t kPhiloxWeyl0 = 0x9E3779B9;
+const std::uint32_t kPhiloxWeyl1 = 0xBB67AE85;
+const unsigned int kPhiloxRounds = 10;
+
+/**
+ * Mix 64-bit value with the SplitMix64 finalizer
+ * @param[in] value Value to mix
+ * @return Mixed value
+ */
+std::uint64_t mix_bits(std::uint64_t value) {
+  value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+  return value ^ (value >> 31);
+}
+}  // namespace
+
+Philox4x32::Counter Philox4x32::block(const Counter& counter, const Key& key) {
+  Counter state = counter;
+  Key round_key = key;
+
+  for (unsigned int i = 0; i < kPhiloxRounds; ++i) {
+    if (i > 0) {
+      round_key[0] += kPhiloxWeyl0;
+      round_key[1] += kPhiloxWeyl1;
+    }
+
+    std::uint64_t product_0 =
+        static_cast<std::uint64_t>(kPhiloxMultiplier0) * state[0];
+    std::uint64_t product_1 =
+        static_cast<std::uint64_t>(kPhiloxMultiplier1) * state[2];
+
+    state = {{static_cast<std::uint32_t>(product_1 >> 32) ^ state[1] ^
+                  round_key[0],
+              static_cast<std::uint32_t>(product_1),
+              static_cast<std::uint32_t>(product_0 >> 32) ^ state[3] ^
+                  round_key[1],
+              static_cast<std::uint32_t>(product_0)}};
+  }
+
+  return state;
+}
+
+RandomStream::RandomStream(std::uint64_t seed, std::uint32_t event,
+                           std::uint32_t component, std::uint32_t stream)
+    : key_{{static_cast<std::uint32_t>(seed),
+            static_cast<std::uint32_t>(seed >> 32)}},
+      counter_{{0, event, component, stream}},
+      position_{0} {
+  refill();
+}
+
+RandomStream::result_type RandomStream::operator()() {
+  if (position_ == block_.size()) {
+    ++counter_[0];
+    refill();
+  }
+
+  return block_[position_++];
+}
+
+double RandomStream::uniform() {
+  std::uint64_t upper = (*this)() >> 5;
+  std::uint64_t lower = (*this)() >> 6;
+
+  return (static_cast<double>(upper) * 67108864.0 +
+          static_cast<double>(lower)) /
+         9007199254740992.0;
+}
+
+void RandomStream::fill_normal(double* values, std::size_t count) {
+  if (count == 0) {
+    return;
+  }
+
+  // Each pair of uniform values gives two independent normal values. The
+  // first uniform value is shifted to (0, 1] so its logarithm is finite.
+  std::size_t num_pairs = (count + 1) / 2;
+  Eigen::ArrayXd radii(num_pairs);
+  Eigen::ArrayXd angles(num_pairs);
+  for (std::size_t i = 0; i < num_pairs; ++i) {
+    radii(i) = 1.0 - uniform();
+    angles(i) = uniform();
+  }
+
+  radii = (-2.0 * radii.log()).sqrt();
+  angles *= 2.0 * M_PI;
+
+  // Cosine terms fill the first half of the buffer and sine terms the rest
+  std::size_t num_sines = count - num_pairs;
+  Eigen::Map<Eigen::ArrayXd> normals(values, count);
+  normals.head(num_pairs) = radii * angles.cos();
+  normals.tail(num_sines) =
+      radii.head(num_sines) * angles.head(num_sines).sin();
+}
+
+void RandomStream::discard(std::uint64_t count) {
+  std::uint64_t target = position_ + count;
+  std::uint64_t blocks = target / block_.size();
+
+  if (blocks > 0) {
+    counter_[0] += static_cast<std::uint32_t>(blocks);
+    refill();
+  }
+  position_ = static_cast<unsigned int>(target % block_.size());
+}
+
+void RandomStream::refill() {
+  block_ = Philox4x32::block(counter_, key_);
+  position_ = 0;
+}
+
+std::uint64_t unique_seed() {
+  static std::atomic<std::uint64_t> calls{0};
+
+  std::uint64_t time = static_cast<std::uint64_t>(
+      std::chrono::high_resolution_clock::now().time_since_epoch().count());
+  std::uint64_t entropy = static_cast<std::uint64_t>(std::random_device{}());
+
+  return mix_bits(time ^ mix_bits(entropy + calls.fetch_add(1)));
+}
+}  // namespace numeric_utils
@@ -34,3 +34,11 @@ std::vector<double> stochastic::StudentstDistribution::inv_cumulative_dist_func(
 
   return evaluations;
 }
+
+double stochastic::StudentstDistribution::transform_exact(double value) const {
+  return std_dev_ * std_normal_quantile(distribution_, value) + mean_;
+}
+
+double stochastic::StudentstDistribution::density(double location) const {
+  return pdf(distribution_, (location - mean_) / std_dev_) / std_dev_;
+}
@@ -30,3 +30,11 @@ std::vector<double> stochastic::UniformDistribution::inv_cumulative_dist_func(
 
   return evaluations;
 }
+
+void stochastic::UniformDistribution::transform_from_std_normal(
+    ValuesRef values) const {
+  double range = upper_bound_ - lower_bound_;
+  values = values.unaryExpr([this, range](double value) {
+    return lower_bound_ + range * std_normal_cdf(value);
+  });
+}
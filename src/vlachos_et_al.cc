@@ -1,33 +1,148 @@
 #define _USE_MATH_DEFINES
 #include <algorithm>
 #include <cmath>
-#include <ctime>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <numeric>
 #include <stdexcept>
 #include <string>
+#include <tuple>
+#include <utility>
 #include <vector>
 // Boost random generator
-#include <boost/random/mersenne_twister.hpp>
 #include <boost/random/uniform_real_distribution.hpp>
-#include <boost/random/variate_generator.hpp>
 // Eigen dense matrices
 #include <Eigen/Dense>
 
+#include "chirp_z_transform.h"
 #include "factory.h"
+#include "fft_plan.h"
 #include "function_dispatcher.h"
 #include "json_object.h"
 #include "lognormal_dist.h"
 #include "normal_dist.h"
 #include "normal_multivar.h"
 #include "numeric_utils.h"
+#include "random_stream.h"
 #include "vlachos_et_al.h"
 
+namespace {
+// Number of time steps over which phasors of exact synthesis are advanced by
+// complex rotation before being reset from the exact phase
+const unsigned int kPhasorResetInterval = 64;
+
+// Index of the random stream used to estimate acceptance probabilities,
+// separate from the phase angles drawn from stream 0
+const std::uint32_t kAcceptanceStream = 1;
+
+// Number of time steps between samples of the spectrum used to estimate the
+// energy of each frequency bin when truncating the frequency range
+const unsigned int kEnergySampleInterval = 8;
+
+// Bytes of spectrum amplitudes and synthesis basis per tile of time steps
+// in batched synthesis, chosen to fit in L2 cache
+const std::size_t kSpectrumTileBytes = 512 * 1024;
+
+// Phasors exp(i * (j * angle_step * time_index + offset_j)) for each
+// frequency index j starting from first_index. Real and imaginary parts are
+// stored separately so that frequencies are processed in SIMD lanes. Each
+// time step advances the phasors by one complex rotation. Every 64 time steps
+// (kPhasorResetInterval) the phasors are recomputed from the exact phase in
+// double precision, so rounding errors of the rotations do not accumulate.
+template <typename T>
+class PhasorLanes {
+ public:
+  PhasorLanes(unsigned int num_freqs, unsigned int first_index,
+              double angle_step, const std::vector<double>& offsets)
+      : first_index_{first_index},
+        angle_step_{angle_step},
+        offsets_(offsets),
+        real_(num_freqs),
+        imag_(num_freqs),
+        rotation_real_(num_freqs),
+        rotation_imag_(num_freqs),
+        rotated_real_(num_freqs) {
+    for (unsigned int j = 0; j < num_freqs; ++j) {
+      rotation_real_(j) =
+          static_cast<T>(std::cos((first_index_ + j) * angle_step_));
+      rotation_imag_(j) =
+          static_cast<T>(std::sin((first_index_ + j) * angle_step_));
+    }
+  }
+
+  // Get phasors at time index. Time indices must be visited consecutively
+  // starting from zero.
+  void advance_to(unsigned int time_index) {
+    if (time_index % kPhasorResetInterval == 0) {
+      for (unsigned int j = 0; j < real_.size(); ++j) {
+        double phase = (first_index_ + j) * angle_step_ * time_index +
+                       (offsets_.empty() ? 0.0 : offsets_[j]);
+        real_(j) = static_cast<T>(std::cos(phase));
+        imag_(j) = static_cast<T>(std::sin(phase));
+      }
+    } else {
+      rotated_real_ = real_ * rotation_real_ - imag_ * rotation_imag_;
+      imag_ = real_ * rotation_imag_ + imag_ * rotation_real_;
+      real_ = rotated_real_;
+    }
+  }
+
+  const Eigen::Array<T, Eigen::Dynamic, 1>& real() const { return real_; }
+  const Eigen::Array<T, Eigen::Dynamic, 1>& imag() const { return imag_; }
+
+ private:
+  unsigned int first_index_;
+  double angle_step_;
+  std::vector<double> offsets_;
+  Eigen::Array<T, Eigen::Dynamic, 1> real_, imag_, rotation_real_,
+      rotation_imag_, rotated_real_;
+};
+
+// Range [first, last) of frequency indices retained after dropping bins at
+// either end of the frequency range, smallest first, for as long as their
+// cumulative energy stays within threshold times the total energy
+std::pair<unsigned int, unsigned int> retained_band(
+    const Eigen::VectorXd& bin_energy, double threshold) {
+  unsigned int first = 0, last = bin_energy.size();
+  double allowance = threshold * bin_energy.sum(), dropped = 0.0;
+  while (last - first > 1) {
+    double lowest = bin_energy(first), highest = bin_energy(last - 1);
+    double next = std::min(lowest, highest);
+    if (dropped + next > allowance) {
+      break;
+    }
+    dropped += next;
+    if (lowest <= highest) {
+      ++first;
+    } else {
+      --last;
+    }
+  }
+  return std::make_pair(first, last);
+}
+
+// Time indices of amplitude frames for interpolated synthesis, which are
+// spaced uniformly from the first time step with the last time step always
+// included as a frame
+std::vector<unsigned int> synthesis_frames(unsigned int num_times,
+                                           unsigned int spacing) {
+  std::vector<unsigned int> frames;
+  for (unsigned int i = 0; i + 1 < num_times; i += spacing) {
+    frames.push_back(i);
+  }
+  frames.push_back(num_times == 0 ? 0 : num_times - 1);
+  return frames;
+}
+}  // namespace
+
 stochastic::VlachosEtAl::VlachosEtAl(double moment_magnitude,
                                      double rupture_distance, double vs30,
                                      double orientation,
                                      unsigned int num_spectra,
-                                     unsigned int num_sims)
+                                     unsigned int num_sims,
+                                     const std::string& sample_generator)
     : StochasticModel(),
       moment_magnitude_{moment_magnitude / 6.0},
       rupture_dist_{(rupture_distance + 5.0) / 30.0},
@@ -39,6 +154,7 @@ stochastic::VlachosEtAl::VlachosEtAl(double moment_magnitude,
       num_spectra_{num_spectra},
       num_sims_{num_sims},
       seed_value_{std::numeric_limits<int>::infinity()},
+      stream_seed_{numeric_utils::unique_seed()},
       model_parameters_{18} {
   model_name_ = "VlachosEtAl";
   // Factors for site condition based on Vs30
@@ -124,13 +240,10 @@ stochastic::VlachosEtAl::VlachosEtAl(double moment_magnitude,
   covariance_ = numeric_utils::corr_to_cov(correlation_matrix,
                                            (variance.array().sqrt()).matrix());
 
-  // Generate realizations of model parameters
+  // Create generator for realizations of model parameters
   sample_generator_ =
       Factory<numeric_utils::RandomGenerator>::instance()->create(
-          "MultivariateNormal");
-  sample_generator_->generate(parameter_realizations_, means_, covariance_,
-                              num_spectra_);
-  parameter_realizations_.transposeInPlace();
+          sample_generator);
 
   // Create distributions for model parameters
   model_parameters_[0] =
@@ -190,23 +303,8 @@ stochastic::VlachosEtAl::VlachosEtAl(double moment_magnitude,
       Factory<stochastic::Distribution, double, double>::instance()->create(
           "LognormalDist", std::move(3.658), std::move(0.375));
 
-  // Standard normal distribution with mean at 0.0 and standard deviation of 1.0
-  auto std_normal_dist =
-      Factory<stochastic::Distribution, double, double>::instance()->create(
-          "NormalDist", std::move(0.0), std::move(1.0));
-
-  physical_parameters_.resize(parameter_realizations_.rows(),
-                              parameter_realizations_.cols());
-
-  // Transform sample normal model parameters to physical space
-  for (unsigned int i = 0; i < parameter_realizations_.rows(); ++i) {
-    for (unsigned int j = 0; j < model_parameters_.size(); ++j) {
-      physical_parameters_(i, j) =
-          (model_parameters_[j]->inv_cumulative_dist_func(
-              std_normal_dist->cumulative_dist_func(
-                  std::vector<double>{parameter_realizations_(i, j)})))[0];
-    }
-  }
+  // Generate realizations of model parameters
+  sample_model_parameters();
 }
 
 
@@ -215,7 +313,8 @@ stochastic::VlachosEtAl::VlachosEtAl(double moment_magnitude,
                                      double orientation,
                                      unsigned int num_spectra,
                                      unsigned int num_sims,
-				     int seed_value)
+				     int seed_value,
+                                     const std::string& sample_generator)
     : StochasticModel(),
       moment_magnitude_{moment_magnitude / 6.0},
       rupture_dist_{(rupture_distance + 5.0) / 30.0},
@@ -227,6 +326,9 @@ stochastic::VlachosEtAl::VlachosEtAl(double moment_magnitude,
       num_spectra_{num_spectra},
       num_sims_{num_sims},
       seed_value_{seed_value},
+      stream_seed_{seed_value != std::numeric_limits<int>::infinity()
+                       ? static_cast<std::uint64_t>(seed_value)
+                       : numeric_utils::unique_seed()},
       model_parameters_{18} {
   model_name_ = "VlachosEtAl";
   // Factors for site condition based on Vs30
@@ -312,13 +414,10 @@ stochastic::VlachosEtAl::VlachosEtAl(double moment_magnitude,
   covariance_ = numeric_utils::corr_to_cov(correlation_matrix,
                                            (variance.array().sqrt()).matrix());
 
-  // Generate realizations of model parameters
+  // Create generator for realizations of model parameters
   sample_generator_ =
       Factory<numeric_utils::RandomGenerator, int>::instance()->create(
-          "MultivariateNormal", std::move(seed_value_));
-  sample_generator_->generate(parameter_realizations_, means_, covariance_,
-                              num_spectra_);
-  parameter_realizations_.transposeInPlace();
+          sample_generator, std::move(seed_value_));
 
   // Create distributions for model parameters
   model_parameters_[0] =
@@ -378,39 +477,219 @@ stochastic::VlachosEtAl::VlachosEtAl(double moment_magnitude,
       Factory<stochastic::Distribution, double, double>::instance()->create(
           "LognormalDist", std::move(3.658), std::move(0.375));
 
-  // Standard normal distribution with mean at 0.0 and standard deviation of 1.0
-  auto std_normal_dist =
-      Factory<stochastic::Distribution, double, double>::instance()->create(
-          "NormalDist", std::move(0.0), std::move(1.0));
-
-  physical_parameters_.resize(parameter_realizations_.rows(),
-                              parameter_realizations_.cols());
-
-  // Transform sample normal model parameters to physical space
-  for (unsigned int i = 0; i < parameter_realizations_.rows(); ++i) {
-    for (unsigned int j = 0; j < model_parameters_.size(); ++j) {
-      physical_parameters_(i, j) =
-          (model_parameters_[j]->inv_cumulative_dist_func(
-              std_normal_dist->cumulative_dist_func(
-                  std::vector<double>{parameter_realizations_(i, j)})))[0];
+  // Generate realizations of model parameters
+  sample_model_parameters();
+}
+
+stochastic::VlachosEtAl::VlachosEtAl(
+    double moment_magnitude, double rupture_distance, double vs30,
+    double orientation, unsigned int num_spectra, unsigned int num_sims,
+    int seed_value, double time_step, double freq_step, double cutoff_freq,
+    double energy_threshold, const std::string& sample_generator)
+    : VlachosEtAl(moment_magnitude, rupture_distance, vs30, orientation,
+                  num_spectra, num_sims, seed_value, sample_generator) {
+  set_discretization(time_step, freq_step, cutoff_freq);
+  set_energy_threshold(energy_threshold);
+}
+
+void stochastic::VlachosEtAl::set_importance_sampling(
+    const Eigen::VectorXd& proposal_shift, double proposal_scale) {
+  if (proposal_shift.size() != means_.size()) {
+    throw std::runtime_error(
+        "\nERROR: In stochastic::VlachosEtAl::set_importance_sampling: "
+        "Proposal shift must have one value per model parameter\n");
+  }
+
+  StochasticModel::set_importance_sampling(proposal_shift, proposal_scale);
+
+  // Redraw model parameters of all spectra from proposal
+  sample_model_parameters();
+}
+
+void stochastic::VlachosEtAl::set_synthesis(SynthesisMethod method,
+                                            double tolerance) {
+  if (tolerance <= 0.0) {
+    throw std::runtime_error(
+        "\nERROR: In stochastic::VlachosEtAl::set_synthesis: Error tolerance "
+        "must be positive\n");
+  }
+  synthesis_ = method;
+  synthesis_tolerance_ = tolerance;
+}
+
+void stochastic::VlachosEtAl::set_discretization(double time_step,
+                                                 double freq_step,
+                                                 double cutoff_freq) {
+  if (time_step <= 0.0 || freq_step <= 0.0 || cutoff_freq < freq_step) {
+    throw std::runtime_error(
+        "\nERROR: In stochastic::VlachosEtAl::set_discretization: Time and "
+        "frequency steps must be positive and cutoff frequency must be at "
+        "least one frequency step\n");
+  }
+  if (cutoff_freq > M_PI / time_step) {
+    throw std::runtime_error(
+        "\nERROR: In stochastic::VlachosEtAl::set_discretization: Cutoff "
+        "frequency exceeds Nyquist frequency of time step\n");
+  }
+  time_step_ = time_step;
+  freq_step_ = freq_step;
+  cutoff_freq_ = cutoff_freq;
+}
+
+void stochastic::VlachosEtAl::set_energy_threshold(double threshold) {
+  if (threshold < 0.0 || threshold >= 1.0) {
+    throw std::runtime_error(
+        "\nERROR: In stochastic::VlachosEtAl::set_energy_threshold: Energy "
+        "threshold must be at least 0 and less than 1\n");
+  }
+  energy_threshold_ = threshold;
+}
+
+bool stochastic::VlachosEtAl::tabulate_quantiles(double tolerance) {
+  bool tabulated = false;
+  for (auto& parameter : model_parameters_) {
+    tabulated = parameter->build_quantile_table(tolerance) || tabulated;
+  }
+  return tabulated;
+}
+
+void stochastic::VlachosEtAl::sample_model_parameters() {
+  if (!importance_sampling()) {
+    sample_generator_->generate(parameter_realizations_, means_, covariance_,
+                                num_spectra_);
+    likelihood_weights_ = Eigen::VectorXd::Ones(num_spectra_);
+  } else {
+    Eigen::VectorXd proposal_means =
+        means_ + proposal_shift_.cwiseProduct(covariance_.diagonal().cwiseSqrt());
+    Eigen::MatrixXd proposal_cov =
+        proposal_scale_ * proposal_scale_ * covariance_;
+    sample_generator_->generate(parameter_realizations_, proposal_means,
+                                proposal_cov, num_spectra_);
+
+    // Realizations that identify_parameters would replace with draws from
+    // the model distribution are instead redrawn from the proposal, so that
+    // weights belong to the parameters used for each spectrum
+    auto to_physical = [this](const Eigen::VectorXd& realization) {
+      Eigen::VectorXd physical = realization;
+      for (unsigned int j = 0; j < model_parameters_.size(); ++j) {
+        model_parameters_[j]->transform_from_std_normal(physical.segment(j, 1));
+      }
+      return physical;
+    };
+
+    bool prepared = false;
+    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic> redraw;
+    for (unsigned int i = 0; i < num_spectra_; ++i) {
+      while (!modes_ordered(to_physical(parameter_realizations_.col(i)))) {
+        if (!prepared) {
+          sample_generator_->prepare(proposal_means, proposal_cov);
+          prepared = true;
+        }
+        sample_generator_->draw(redraw, 1);
+        parameter_realizations_.col(i) = redraw.col(0);
+      }
     }
+
+    // Realizations with unordered modes are rejected from both the model
+    // and the proposal distribution, but not in the same proportion.
+    // Likelihood ratios are scaled by the ratio of estimated acceptance
+    // probabilities, so weights are those of the accepted model distribution
+    // with respect to the accepted proposal.
+    auto accepted_realizations = [this](const Eigen::MatrixXd& realizations) {
+      Eigen::MatrixXd physical = realizations.transpose();
+      for (unsigned int j = 0; j < model_parameters_.size(); ++j) {
+        model_parameters_[j]->transform_from_std_normal(physical.col(j));
+      }
+
+      Eigen::Array<bool, 1, Eigen::Dynamic> accepted(realizations.cols());
+      for (Eigen::Index i = 0; i < realizations.cols(); ++i) {
+        accepted(i) = modes_ordered(physical.row(i).transpose());
+      }
+      return accepted;
+    };
+
+    // Acceptance probabilities are estimated from a separate random stream,
+    // so estimating them does not advance or re-prepare the seeded sample
+    // generator of model parameters
+    numeric_utils::RandomStream acceptance_stream(stream_seed_, 0, 0,
+                                                  kAcceptanceStream);
+    double acceptance_ratio = numeric_utils::acceptance_ratio(
+        accepted_realizations, means_, covariance_, proposal_means,
+        proposal_cov, acceptance_stream);
+
+    likelihood_weights_ =
+        numeric_utils::normal_likelihood_ratios(parameter_realizations_,
+                                                means_, covariance_,
+                                                proposal_means, proposal_cov) *
+        acceptance_ratio;
+  }
+  parameter_realizations_.transposeInPlace();
+
+  // Transform sample normal model parameters to physical space, one column
+  // of realizations per model parameter
+  physical_parameters_ = parameter_realizations_;
+  for (unsigned int j = 0; j < model_parameters_.size(); ++j) {
+    model_parameters_[j]->transform_from_std_normal(
+        physical_parameters_.col(j));
   }
 }
 
 utilities::JsonObject stochastic::VlachosEtAl::generate(
     const std::string& event_name, bool units) {
+  if (precision_ == Precision::Single) {
+    return generate_event<float>(event_name, units);
+  }
 
-  // Pool of acceleration time histories based on number of spectra and
-  // simulations requested
-  std::vector<std::vector<std::vector<double>>> acceleration_pool(
-      num_spectra_,
-      std::vector<std::vector<double>>(num_sims_, std::vector<double>()));
+  return generate_event<double>(event_name, units);
+}
+
+template <typename T>
+utilities::JsonObject stochastic::VlachosEtAl::generate_event(
+    const std::string& event_name, bool units) {
+
+  // Pool of x and y acceleration time histories based on number of spectra
+  // and simulations requested. Histories are rotated and converted once,
+  // after their family is generated, and used for both adaptive ensemble
+  // statistics and output.
+  std::vector<std::vector<std::vector<std::vector<T>>>> acceleration_pool(
+      num_spectra_, std::vector<std::vector<std::vector<T>>>(
+                        num_sims_, std::vector<std::vector<T>>(2)));
+
+  // Draw new random streams for each unseeded ensemble
+  if (seed_value_ == std::numeric_limits<int>::infinity()) {
+    stream_seed_ = numeric_utils::unique_seed();
+  }
 
   // Generate family of time histories for each spectrum. Family size is
-  // specified by requested number of simulations per spectra.
+  // specified by requested number of simulations per spectra. Adaptive
+  // ensembles stop after the family at which target statistics converge.
+  unsigned int num_generated = num_spectra_;
+  numeric_utils::OnlineEstimator estimator;
   try {
     for (unsigned int i = 0; i < num_spectra_; ++i) {
-      time_history_family(acceleration_pool[i], physical_parameters_.row(i));
+      std::vector<std::vector<T>> family(num_sims_);
+      time_history_family(family, physical_parameters_.row(i), i);
+      for (unsigned int j = 0; j < num_sims_; ++j) {
+        rotate_acceleration(family[j], acceleration_pool[i][j][0],
+                            acceleration_pool[i][j][1], units);
+      }
+
+      if (adaptive_ensemble()) {
+        // Families are independent samples, weighted by likelihood of their
+        // model parameters
+        Eigen::VectorXd sample;
+        for (unsigned int j = 0; j < num_sims_; ++j) {
+          Eigen::VectorXd value =
+              event_statistic(acceleration_pool[i][j], time_step_);
+          sample = j == 0 ? value : Eigen::VectorXd(sample + value);
+        }
+        estimator.add(likelihood_weights_(i) / num_sims_ * sample);
+
+        if (adaptive_converged(estimator)) {
+          num_generated = i + 1;
+          break;
+        }
+      }
     }
   } catch (const std::exception& e) {
     std::cerr << e.what();
@@ -419,7 +698,7 @@ utilities::JsonObject stochastic::VlachosEtAl::generate(
 
   // Create JsonObject for events
   auto events = utilities::JsonObject();
-  std::vector<utilities::JsonObject> events_array(num_spectra_ * num_sims_);
+  std::vector<utilities::JsonObject> events_array(num_generated * num_sims_);
 
   // Add pattern information for JSON
   auto pattern_x = utilities::JsonObject();
@@ -434,33 +713,31 @@ utilities::JsonObject stochastic::VlachosEtAl::generate(
   // Create JSON for specific event
   auto event_data = utilities::JsonObject();
   // Loop over spectra
-  for (unsigned int i = 0; i < num_spectra_; ++i) {
+  for (unsigned int i = 0; i < num_generated; ++i) {
     // Loop over different simulations for current spectra
     for (unsigned int j = 0; j < num_sims_; ++j) {
       event_data.add_value("name", event_name + "_Spectra" + std::to_string(i) +
                                        "_Sim" + std::to_string(j));
       event_data.add_value("type", "Seismic");
       event_data.add_value("dT", time_step_);
-      event_data.add_value("numSteps", acceleration_pool[i][j].size());
+      event_data.add_value("numSteps", acceleration_pool[i][j][0].size());
+      if (importance_sampling()) {
+        event_data.add_value("likelihoodWeight", likelihood_weights_(i));
+      }
       event_data.add_value(
           "pattern", std::vector<utilities::JsonObject>{pattern_x, pattern_y});
 
-      // Rotate accelerations, if necessary      
-      std::vector<double> x_accels(acceleration_pool[i][j].size());
-      std::vector<double> y_accels(acceleration_pool[i][j].size());
-      rotate_acceleration(acceleration_pool[i][j], x_accels, y_accels, units);
-
       // Add time histories for x and y directions to event
       auto time_history_x = utilities::JsonObject();
       auto time_history_y = utilities::JsonObject();
       time_history_x.add_value("name", "accel_x");
       time_history_x.add_value("type", "Value");
       time_history_x.add_value("dT", time_step_);
-      time_history_x.add_value("data", x_accels);
+      time_history_x.add_value("data", acceleration_pool[i][j][0]);
       time_history_y.add_value("name", "accel_y");
       time_history_y.add_value("type", "Value");
       time_history_y.add_value("dT", time_step_);
-      time_history_y.add_value("data", y_accels);
+      time_history_y.add_value("data", acceleration_pool[i][j][1]);
       event_data.add_value("timeSeries", std::vector<utilities::JsonObject>{
                                              time_history_x, time_history_y});
       events_array[i * num_sims_ + j] = event_data;	
@@ -469,6 +746,10 @@ utilities::JsonObject stochastic::VlachosEtAl::generate(
   }
 
   events.add_value("Events", events_array);
+  if (adaptive_ensemble()) {
+    events.add_value("AdaptiveEnsemble",
+                     adaptive_summary(estimator, num_generated * num_sims_));
+  }
 
   return events;
 }
@@ -493,7 +774,20 @@ bool stochastic::VlachosEtAl::generate(const std::string& event_name,
 
 bool stochastic::VlachosEtAl::time_history_family(
     std::vector<std::vector<double>>& time_histories,
-    const Eigen::VectorXd& parameters) const {
+    const Eigen::VectorXd& parameters, unsigned int family_index) const {
+  return time_history_family_impl(time_histories, parameters, family_index);
+}
+
+bool stochastic::VlachosEtAl::time_history_family(
+    std::vector<std::vector<float>>& time_histories,
+    const Eigen::VectorXd& parameters, unsigned int family_index) const {
+  return time_history_family_impl(time_histories, parameters, family_index);
+}
+
+template <typename T>
+bool stochastic::VlachosEtAl::time_history_family_impl(
+    std::vector<std::vector<T>>& time_histories,
+    const Eigen::VectorXd& parameters, unsigned int family_index) const {
   bool status = true;
   auto identified_parameters = identify_parameters(parameters);
   
@@ -556,24 +850,68 @@ bool stochastic::VlachosEtAl::time_history_family(
     highpass_butter_energy[i] = freq_ratio_sq / (1.0 + freq_ratio_sq);
   }
 
-  // Calculate the evolutionary power spectrum with unit variance at
-  // each time step
-  Eigen::MatrixXd power_spectrum(times.size(), frequencies.size());
-
-  for (unsigned int i = 0; i < times.size(); ++i) {
-    power_spectrum.row(i) =
-        kt_2(std::vector<double>{mode_1_freqs[i], identified_parameters[8], 1.0,
-                                 mode_2_freqs[i], identified_parameters[9],
-                                 mode_2_participation[i]},
-             frequencies, highpass_butter_energy);
-
-    double freq_domain_integral =
-      2.0 * numeric_utils::trapazoid_rule(power_spectrum.row(i), freq_step_);
-    
-    power_spectrum.row(i) =
-        power_spectrum.row(i) * amplitude_modulation[i] / freq_domain_integral;
-
+  auto kt_parameters = [&](unsigned int i) {
+    return std::vector<double>{mode_1_freqs[i], identified_parameters[8], 1.0,
+                               mode_2_freqs[i], identified_parameters[9],
+                               mode_2_participation[i]};
+  };
+  std::vector<double> spectrum_row(frequencies.size());
+
+  // When truncating the frequency range, the spectrum is still normalized to
+  // unit variance over the full frequency grid, so truncation only removes
+  // energy. The integral over the full grid is computed once per time step,
+  // while the energy of each frequency bin summed over time is estimated
+  // from a subset of time steps, since the shape of the spectrum changes
+  // slowly
+  unsigned int first_freq = 0, last_freq = frequencies.size();
+  std::vector<double> freq_domain_integrals;
+  if (energy_threshold_ > 0.0) {
+    freq_domain_integrals.resize(times.size());
+    Eigen::VectorXd bin_energy = Eigen::VectorXd::Zero(frequencies.size());
+    for (unsigned int i = 0; i < times.size(); ++i) {
+      freq_domain_integrals[i] =
+          2.0 * kt_2(kt_parameters(i), frequencies, highpass_butter_energy,
+                     spectrum_row.data());
+      if (i % kEnergySampleInterval == 0) {
+        bin_energy += Eigen::Map<const Eigen::VectorXd>(spectrum_row.data(),
+                                                        spectrum_row.size()) *
+                      (amplitude_modulation[i] / freq_domain_integrals[i]);
+      }
+    }
+    std::tie(first_freq, last_freq) =
+        retained_band(bin_energy, energy_threshold_);
   }
+  unsigned int num_band_freqs = last_freq - first_freq;
+  std::vector<double> band_frequencies(frequencies.begin() + first_freq,
+                                       frequencies.begin() + last_freq);
+  std::vector<double> band_highpass_energy(
+      highpass_butter_energy.begin() + first_freq,
+      highpass_butter_energy.begin() + last_freq);
+
+  // Amplitudes of the evolutionary power spectrum with unit variance at
+  // each time step over the retained frequencies are computed for tiles of
+  // consecutive time steps. Without truncation, the spectrum at each time
+  // step is integrated while it is evaluated and normalized while it is
+  // still in cache.
+  SpectrumTile<T> spectrum_tile = [&](unsigned int start,
+                                      unsigned int num_rows,
+                                      AmplitudeMatrix<T>& tile) {
+    for (unsigned int row = 0; row < num_rows; ++row) {
+      unsigned int i = start + row;
+      double band_integral =
+          2.0 * kt_2(kt_parameters(i), band_frequencies, band_highpass_energy,
+                     spectrum_row.data());
+      double freq_domain_integral = freq_domain_integrals.empty()
+                                        ? band_integral
+                                        : freq_domain_integrals[i];
+      tile.row(row) =
+          (Eigen::Map<const Eigen::RowVectorXd>(spectrum_row.data(),
+                                                num_band_freqs) *
+           (amplitude_modulation[i] / freq_domain_integral))
+              .cwiseSqrt()
+              .template cast<T>();
+    }
+  };
 
   // Get coefficients for highpass Butterworth filter  
   int num_samples =
@@ -594,11 +932,35 @@ bool stochastic::VlachosEtAl::time_history_family(
           ->dispatch("ImpulseResponse", hp_butter[0], hp_butter[1],
                      filter_order, num_samples);
   
+  // Transform impulse response once for all time histories in family, sized
+  // so that each history is filtered with a single transform
+  numeric_utils::BasicConvolutionKernel<T> filter_kernel(
+      std::vector<T>(impulse_response.begin(), impulse_response.end()),
+      times.size());
+
   try {
-    // Generate family of time histories
+    // Generate family of time histories. Exact synthesis of all histories is
+    // batched into matrix products over spectrum tiles, so the spectrum is
+    // never stored for the whole record. Interpolated synthesis requires the
+    // amplitudes at all time steps to place its frames. In antithetic pairs,
+    // the second history reuses the phase angles of the first shifted by pi.
+    if (synthesis_ == SynthesisMethod::Exact) {
+      batched_synthesis(time_histories, times.size(), num_band_freqs,
+                        first_freq, spectrum_tile, family_index);
+    } else {
+      AmplitudeMatrix<T> amplitudes(times.size(), num_band_freqs);
+      spectrum_tile(0, times.size(), amplitudes);
+      unsigned int spacing = frame_spacing(amplitudes);
+      for (unsigned int i = 0; i < num_sims_; ++i) {
+        bool antithetic = antithetic_ && i % 2 == 1;
+        simulate_time_history_impl(
+            time_histories[i], amplitudes,
+            family_index * num_sims_ + (antithetic ? i - 1 : i), antithetic,
+            spacing, first_freq);
+      }
+    }
     for (unsigned int i = 0; i < num_sims_; ++i) {
-      simulate_time_history(time_histories[i], power_spectrum);
-      post_process(time_histories[i], impulse_response);
+      post_process_impl(time_histories[i], filter_kernel);
     }
   } catch (const std::exception& e) {
     std::cerr << e.what();
@@ -610,58 +972,281 @@ bool stochastic::VlachosEtAl::time_history_family(
 }
 
 void stochastic::VlachosEtAl::simulate_time_history(
-    std::vector<double>& time_history,
-    const Eigen::MatrixXd& power_spectrum) const {
-  unsigned int num_times = power_spectrum.rows(),
-               num_freqs = power_spectrum.cols();
+    std::vector<double>& time_history, const Eigen::MatrixXd& power_spectrum,
+    unsigned int event_index, bool antithetic) const {
+  const AmplitudeMatrix<double> amplitudes = power_spectrum.cwiseSqrt();
+  simulate_time_history_impl(time_history, amplitudes, event_index,
+                             antithetic, frame_spacing(amplitudes), 0);
+}
 
-  time_history.resize(num_times, 0.0);
+void stochastic::VlachosEtAl::simulate_time_history(
+    std::vector<float>& time_history, const Eigen::MatrixXf& power_spectrum,
+    unsigned int event_index, bool antithetic) const {
+  const AmplitudeMatrix<float> amplitudes = power_spectrum.cwiseSqrt();
+  simulate_time_history_impl(time_history, amplitudes, event_index,
+                             antithetic, frame_spacing(amplitudes), 0);
+}
 
-  std::vector<double> times(num_times);
-  std::vector<double> frequencies(num_freqs);
+std::vector<double> stochastic::VlachosEtAl::phase_angles(
+    unsigned int num_freqs, unsigned int event_index, bool antithetic) const {
+  // Draw phase angles from the random stream keyed on this time history, so
+  // histories may be simulated in any order or concurrently
+  numeric_utils::RandomStream angle_stream(stream_seed_, event_index);
+  boost::random::uniform_real_distribution<> distribution(0.0, 2.0 * M_PI);
 
-  for (unsigned int i = 0; i < times.size(); ++i) {
-    times[i] = i * time_step_;
+  std::vector<double> phase_angle(num_freqs, 0.0);
+
+  const double phase_shift = antithetic ? M_PI : 0.0;
+  for (auto & angle : phase_angle) {
+    angle = distribution(angle_stream) + phase_shift;
   }
 
-  for (unsigned int i = 0; i < frequencies.size(); ++i) {
-    frequencies[i] = i * freq_step_;
+  return phase_angle;
+}
+
+template <typename T>
+void stochastic::VlachosEtAl::simulate_time_history_impl(
+    std::vector<T>& time_history, const AmplitudeMatrix<T>& amplitudes,
+    unsigned int event_index, bool antithetic, unsigned int frame_spacing,
+    unsigned int first_freq) const {
+  unsigned int num_times = amplitudes.rows(),
+               num_freqs = amplitudes.cols();
+
+  time_history.resize(num_times, T(0));
+
+  // Phase angles are drawn for all frequencies up to the last retained one,
+  // so each retained frequency has the same phase angle as without
+  // truncation
+  auto phase_angle =
+      phase_angles(first_freq + num_freqs, event_index, antithetic);
+  phase_angle.erase(phase_angle.begin(), phase_angle.begin() + first_freq);
+
+  if (frame_spacing > 1) {
+    interpolated_synthesis(time_history, amplitudes, phase_angle,
+                           frame_spacing, first_freq);
+  } else {
+    exact_synthesis(time_history, amplitudes, phase_angle, first_freq);
   }
+}
 
-  static unsigned int history_seed = static_cast<unsigned int>(std::time(nullptr));
-  history_seed = history_seed + 10;
-  
-  auto generator =
-    seed_value_ != std::numeric_limits<int>::infinity()
-    ? boost::random::mt19937(static_cast<unsigned int>(seed_value_ + 10))
-    : boost::random::mt19937(history_seed);
+template <typename T>
+void stochastic::VlachosEtAl::exact_synthesis(
+    std::vector<T>& time_history, const AmplitudeMatrix<T>& amplitudes,
+    const std::vector<double>& phase_angle, unsigned int first_freq) const {
+  unsigned int num_times = amplitudes.rows();
+  PhasorLanes<T> phasors(amplitudes.cols(), first_freq,
+                         freq_step_ * time_step_, phase_angle);
 
-  boost::random::uniform_real_distribution<> distribution(0.0, 2.0 * M_PI);
-  boost::random::variate_generator<boost::random::mt19937&,
-                                   boost::random::uniform_real_distribution<>>
-      angle_gen(generator, distribution);
+  const T scale = static_cast<T>(2.0 * std::sqrt(freq_step_));
+  for (unsigned int i = 0; i < num_times; ++i) {
+    phasors.advance_to(i);
+    time_history[i] =
+        scale * (time_history[i] +
+                 (amplitudes.row(i).transpose().array() * phasors.real()).sum());
+  }
+}
 
-  std::vector<double> phase_angle(num_freqs, 0.0);
+template <typename T>
+void stochastic::VlachosEtAl::batched_synthesis(
+    std::vector<std::vector<T>>& time_histories, unsigned int num_times,
+    unsigned int num_freqs, unsigned int first_freq,
+    const SpectrumTile<T>& spectrum_tile, unsigned int family_index) const {
+  // Real part of amplitude times exp(i * (frequency * time + phase)) is
+  // the product of [A cos(frequency * time), A sin(frequency * time)] with
+  // [cos(phase); -sin(phase)], so each block of time steps is synthesized
+  // for all histories with a single matrix product. In antithetic pairs,
+  // the second history reuses the phase angles of the first shifted by pi.
+  Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> phase_factors(
+      2 * num_freqs, num_sims_);
+  for (unsigned int k = 0; k < num_sims_; ++k) {
+    bool antithetic = antithetic_ && k % 2 == 1;
+    auto phase_angle = phase_angles(
+        first_freq + num_freqs,
+        family_index * num_sims_ + (antithetic ? k - 1 : k), antithetic);
+    for (unsigned int j = 0; j < num_freqs; ++j) {
+      phase_factors(j, k) =
+          static_cast<T>(std::cos(phase_angle[first_freq + j]));
+      phase_factors(num_freqs + j, k) =
+          static_cast<T>(-std::sin(phase_angle[first_freq + j]));
+    }
+    time_histories[k].resize(num_times, T(0));
+  }
 
-  for (auto & angle : phase_angle) {
-    angle = angle_gen();
+  // Amplitude tile and basis for each tile of time steps fit in cache
+  unsigned int tile_size = std::max(
+      1u, std::min(num_times, static_cast<unsigned int>(
+                                  kSpectrumTileBytes /
+                                  (3 * num_freqs * sizeof(T)))));
+
+  PhasorLanes<T> phasors(num_freqs, first_freq, freq_step_ * time_step_,
+                         std::vector<double>());
+  AmplitudeMatrix<T> amplitudes(tile_size, num_freqs);
+  AmplitudeMatrix<T> basis(tile_size, 2 * num_freqs);
+  Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> block_histories;
+  const T scale = static_cast<T>(2.0 * std::sqrt(freq_step_));
+
+  for (unsigned int start = 0; start < num_times; start += tile_size) {
+    unsigned int block_size = std::min(tile_size, num_times - start);
+    spectrum_tile(start, block_size, amplitudes);
+    for (unsigned int i = 0; i < block_size; ++i) {
+      phasors.advance_to(start + i);
+      auto amplitude_row = amplitudes.row(i).array();
+      basis.row(i).head(num_freqs).array() =
+          amplitude_row * phasors.real().transpose();
+      basis.row(i).tail(num_freqs).array() =
+          amplitude_row * phasors.imag().transpose();
+    }
+
+    block_histories.noalias() = basis.topRows(block_size) * phase_factors;
+
+    for (unsigned int k = 0; k < num_sims_; ++k) {
+      for (unsigned int i = 0; i < block_size; ++i) {
+        time_histories[k][start + i] =
+            scale * (time_histories[k][start + i] + block_histories(i, k));
+      }
+    }
+  }
+}
+
+template <typename T>
+unsigned int stochastic::VlachosEtAl::frame_spacing(
+    const AmplitudeMatrix<T>& amplitudes) const {
+  unsigned int num_times = amplitudes.rows();
+  if (synthesis_ == SynthesisMethod::Exact || num_times < 3) {
+    return 1;
   }
 
-  // Loop over all frequencies and times to calculate time history
+  double total_energy = 0.0;
   for (unsigned int i = 0; i < num_times; ++i) {
+    total_energy += static_cast<double>(amplitudes.row(i).squaredNorm());
+  }
+  if (total_energy == 0.0) {
+    return num_times - 1;
+  }
+
+  // Interpolation only reduces work when each frame, which costs a forward
+  // and backward complex transform plus a coefficient per frequency,
+  // replaces enough time steps of the exact sum. Costs are relative to a
+  // multiply-add and phasor rotation of the exact sum.
+  unsigned int num_freqs = amplitudes.cols();
+  auto cost_effective = [num_freqs](unsigned int spacing) {
+    double transform_length = static_cast<double>(
+        numeric_utils::next_fast_fft_length(num_freqs + 2 * spacing));
+    return 2.5 * transform_length * std::log2(transform_length) +
+               10.0 * num_freqs <
+           static_cast<double>(spacing) * num_freqs;
+  };
+
+  // Relative root-mean-square error of amplitudes interpolated between frames
+  auto interpolation_error = [&amplitudes, num_times,
+                              total_energy](unsigned int spacing) {
+    auto frames = synthesis_frames(num_times, spacing);
+    double error = 0.0;
+    for (unsigned int k = 0; k + 1 < frames.size(); ++k) {
+      T width = static_cast<T>(frames[k + 1] - frames[k]);
+      for (unsigned int i = frames[k] + 1; i < frames[k + 1]; ++i) {
+        T weight = (i - frames[k]) / width;
+        error += static_cast<double>(
+            ((T(1) - weight) * amplitudes.row(frames[k]) +
+             weight * amplitudes.row(frames[k + 1]) - amplitudes.row(i))
+                .squaredNorm());
+      }
+    }
+    return std::sqrt(error / total_energy);
+  };
+
+  // Start from the narrowest cost effective spacing and double spacing while
+  // interpolation error stays within tolerance
+  unsigned int spacing = 2;
+  while (2 * spacing < num_times && !cost_effective(spacing)) {
+    spacing *= 2;
+  }
+  if (!cost_effective(spacing) ||
+      interpolation_error(spacing) > synthesis_tolerance_) {
+    return 1;
+  }
+  while (2 * spacing < num_times &&
+         interpolation_error(2 * spacing) <= synthesis_tolerance_) {
+    spacing *= 2;
+  }
+
+  return spacing;
+}
+
+template <typename T>
+void stochastic::VlachosEtAl::interpolated_synthesis(
+    std::vector<T>& time_history, const AmplitudeMatrix<T>& amplitudes,
+    const std::vector<double>& phase_angle, unsigned int frame_spacing,
+    unsigned int first_freq) const {
+  unsigned int num_times = amplitudes.rows(),
+               num_freqs = amplitudes.cols();
+  auto frames = synthesis_frames(num_times, frame_spacing);
+
+  // Each frame contributes over the segments on either side of it, which
+  // together span at most twice the frame spacing. Coefficients below the
+  // first retained frequency are zero.
+  numeric_utils::ChirpZTransform transform(first_freq + num_freqs,
+                                           2 * frame_spacing + 1,
+                                           freq_step_ * time_step_);
+  std::vector<std::complex<double>> coefficients(first_freq + num_freqs, 0.0);
+  std::vector<std::complex<double>> stationary(transform.num_outputs());
+  std::vector<double> sums(num_times, 0.0);
+
+  for (unsigned int k = 0; k < frames.size(); ++k) {
+    unsigned int start = k == 0 ? frames[k] : frames[k - 1];
+    unsigned int end = k + 1 == frames.size() ? frames[k] : frames[k + 1];
+
+    // Phase at start of support is included in coefficients so that the
+    // transform is evaluated at times relative to the start
+    double start_time = start * time_step_;
     for (unsigned int j = 0; j < num_freqs; ++j) {
-     time_history[i] =
-          time_history[i] +
-          std::sqrt(power_spectrum(i, j)) *
-              std::cos(frequencies[j] * times[i] + phase_angle[j]);      
+      coefficients[first_freq + j] = std::polar(
+          static_cast<double>(amplitudes(frames[k], j)),
+          (first_freq + j) * freq_step_ * start_time + phase_angle[j]);
+    }
+    transform.execute(coefficients.data(), stationary.data());
+
+    for (unsigned int i = start; i <= end; ++i) {
+      double weight =
+          i < frames[k]
+              ? static_cast<double>(i - start) / (frames[k] - start)
+              : i > frames[k]
+                    ? static_cast<double>(end - i) / (end - frames[k])
+                    : 1.0;
+      sums[i] += weight * stationary[i - start].real();
     }
-    time_history[i] = 2.0 * std::sqrt(freq_step_) * time_history[i];
+  }
+
+  const double scale = 2.0 * std::sqrt(freq_step_);
+  for (unsigned int i = 0; i < num_times; ++i) {
+    time_history[i] = static_cast<T>(scale * (time_history[i] + sums[i]));
   }
 }
 
 bool stochastic::VlachosEtAl::post_process(
     std::vector<double>& time_history,
     const std::vector<double>& filter_imp_resp) const {
+  numeric_utils::ConvolutionKernel filter_kernel(filter_imp_resp,
+                                                 time_history.size());
+  return post_process(time_history, filter_kernel);
+}
+
+bool stochastic::VlachosEtAl::post_process(
+    std::vector<double>& time_history,
+    const numeric_utils::ConvolutionKernel& filter_kernel) const {
+  return post_process_impl(time_history, filter_kernel);
+}
+
+bool stochastic::VlachosEtAl::post_process(
+    std::vector<float>& time_history,
+    const numeric_utils::BasicConvolutionKernel<float>& filter_kernel) const {
+  return post_process_impl(time_history, filter_kernel);
+}
+
+template <typename T>
+bool stochastic::VlachosEtAl::post_process_impl(
+    std::vector<T>& time_history,
+    const numeric_utils::BasicConvolutionKernel<T>& filter_kernel) const {
   
   bool status = true;
   double time_hann_2 = 1.0;
@@ -692,14 +1277,14 @@ bool stochastic::VlachosEtAl::post_process(
 
   // Apply window
   for (unsigned int i = 0; i < time_history.size(); ++i) {
-    time_history[i] = window[i] * (time_history[i] - mean);
+    time_history[i] = static_cast<T>(window[i] * (time_history[i] - mean));
   }
 
   // Apply 4th order Butterworth filter
-  std::vector<double> filtered_history(filter_imp_resp.size() +
+  std::vector<T> filtered_history(filter_kernel.size() +
                                        time_history.size() - 1);
   try {
-    numeric_utils::convolve_1d(filter_imp_resp, time_history, filtered_history);
+    filter_kernel.convolve(time_history, filtered_history);
   } catch (const std::exception& e) {
     std::cerr << e.what();
     status = false;
@@ -714,92 +1299,65 @@ bool stochastic::VlachosEtAl::post_process(
 
 Eigen::VectorXd stochastic::VlachosEtAl::identify_parameters(
     const Eigen::VectorXd& initial_params) const {
-  // Initialize non-dimensional cumulative energy
-  std::vector<double> energy(static_cast<unsigned int>(1.0 / 0.05) + 1, 0.0);
-
-  for (unsigned int i = 1; i < energy.size(); ++i) {
-    energy[i] = energy[i - 1] + 0.05;
-  }
-
-  // Initialze mode 1 parameters and frequencies
-  std::vector<double> mode_1_params = {initial_params(2),
-				       initial_params(3),
-				       initial_params(4)};
-  auto mode_1_freqs = modal_frequencies(mode_1_params, energy);
-
-  // Initialize mode 2 parameters and frequencies
-  std::vector<double> mode_2_params = {initial_params(5),
-				       initial_params(6),
-				       initial_params(7)};
-  auto mode_2_freqs = modal_frequencies(mode_2_params, energy);
-
-  double mode_1_mean = initial_params(11), mode_2_mean = initial_params(14);
-
-  // Standard normal distribution with mean at 0.0 and standard deviation of 1.0
-  auto std_normal_dist =
-      Factory<stochastic::Distribution, double, double>::instance()->create(
-          "NormalDist", std::move(0.0), std::move(1.0));  
-
   Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic> realizations(
       initial_params.size(), 1);
   Eigen::VectorXd transformed_realizations = initial_params;
 
-  // Check if any mode 1 dominant frequencies across all non-dimensional energy
-  // values are greater than the corresponding values for mode 2
-  bool freq_comparison = false;
-  for (unsigned int i = 0; i < mode_1_freqs.size(); ++i) {
-    if (mode_1_freqs[i] > mode_2_freqs[i]) {
-      freq_comparison = true;
-      break;
-    }
+  bool ordered = modes_ordered(initial_params);
+
+  // Decompose covariance matrix once for all realizations drawn while
+  // searching for suitable parameter values
+  if (!ordered) {
+    sample_generator_->prepare(means_, covariance_);
   }
 
   // Iterate until suitable parameter values have been identified
-  while (freq_comparison || (mode_1_mean > mode_2_mean)) {
+  while (!ordered) {
     
     // Generate realizations of parameters
-    sample_generator_->generate(realizations, means_, covariance_, 1);
+    sample_generator_->draw(realizations, 1);
     
     // Transform parameter realizations to physical space
+    transformed_realizations = realizations.col(0);
     for (unsigned int i = 0; i < initial_params.size(); ++i) {
-      transformed_realizations(i) =
-          (model_parameters_[i]->inv_cumulative_dist_func(
-              std_normal_dist->cumulative_dist_func(
-                  std::vector<double>{realizations(i, 0)})))[0];
+      model_parameters_[i]->transform_from_std_normal(
+          transformed_realizations.segment(i, 1));
     }
 
-    // Calculate dominant modal frequencies
-    mode_1_freqs =
-        modal_frequencies(std::vector<double>{transformed_realizations(2),
-                                              transformed_realizations(3),
-                                              transformed_realizations(4)},
-                          energy);
-
-    mode_2_params = {transformed_realizations(5), transformed_realizations(6),
-                     transformed_realizations(7)};
-    mode_2_freqs =
-        modal_frequencies(std::vector<double>{transformed_realizations(5),
-                                              transformed_realizations(6),
-                                              transformed_realizations(7)},
-                          energy);
-
-    mode_1_mean = transformed_realizations(11);
-    mode_2_mean = transformed_realizations(14);
-
-    // Check if any mode 1 dominant frequencies across all non-dimensional energy values
-    // are greater than the corresponding values for mode 2
-    freq_comparison = false;
-    for (unsigned int i = 0; i < mode_1_freqs.size(); ++i) {
-      if (mode_1_freqs[i] > mode_2_freqs[i]) {
-	freq_comparison = true;
-	break;
-      }
-    }
+    ordered = modes_ordered(transformed_realizations);
   }
 
   return transformed_realizations;
 }
 
+bool stochastic::VlachosEtAl::modes_ordered(
+    const Eigen::VectorXd& parameters) const {
+  // Initialize non-dimensional cumulative energy
+  std::vector<double> energy(static_cast<unsigned int>(1.0 / 0.05) + 1, 0.0);
+
+  for (unsigned int i = 1; i < energy.size(); ++i) {
+    energy[i] = energy[i - 1] + 0.05;
+  }
+
+  // Calculate dominant modal frequencies
+  auto mode_1_freqs = modal_frequencies(
+      std::vector<double>{parameters(2), parameters(3), parameters(4)},
+      energy);
+  auto mode_2_freqs = modal_frequencies(
+      std::vector<double>{parameters(5), parameters(6), parameters(7)},
+      energy);
+
+  // Check if any mode 1 dominant frequencies across all non-dimensional
+  // energy values are greater than the corresponding values for mode 2
+  for (unsigned int i = 0; i < mode_1_freqs.size(); ++i) {
+    if (mode_1_freqs[i] > mode_2_freqs[i]) {
+      return false;
+    }
+  }
+
+  return parameters(11) <= parameters(14);
+}
+
 std::vector<double> stochastic::VlachosEtAl::modal_frequencies(
     const std::vector<double>& parameters,
     const std::vector<double>& energy) const {
@@ -868,7 +1426,15 @@ Eigen::VectorXd stochastic::VlachosEtAl::kt_2(
     const std::vector<double>& frequencies,
     const std::vector<double>& highpass_butter) const {
   Eigen::VectorXd power_spectrum(frequencies.size());
-  double mode1 = 0, mode2 = 0;
+  kt_2(parameters, frequencies, highpass_butter, power_spectrum.data());
+  return power_spectrum;
+}
+
+double stochastic::VlachosEtAl::kt_2(
+    const std::vector<double>& parameters,
+    const std::vector<double>& frequencies,
+    const std::vector<double>& highpass_butter, double* power_spectrum) const {
+  double mode1 = 0, mode2 = 0, integral = 0;
   
   for (unsigned int i = 0; i < frequencies.size(); ++i) {
     mode1 = parameters[2] *
@@ -885,14 +1451,32 @@ Eigen::VectorXd stochastic::VlachosEtAl::kt_2(
                  std::pow(frequencies[i] / parameters[3], 2));
 
     power_spectrum[i] = highpass_butter[i] * (mode1 + mode2);
+
+    if (i > 0) {
+      integral += 0.5 * (power_spectrum[i - 1] + power_spectrum[i]) *
+                  (frequencies[i] - frequencies[i - 1]);
+    }
   }
 
-  return power_spectrum;
+  return integral;
 }
 
 void stochastic::VlachosEtAl::rotate_acceleration(
     const std::vector<double>& acceleration, std::vector<double>& x_accels,
     std::vector<double>& y_accels, bool units) const {
+  rotate_acceleration_impl(acceleration, x_accels, y_accels, units);
+}
+
+void stochastic::VlachosEtAl::rotate_acceleration(
+    const std::vector<float>& acceleration, std::vector<float>& x_accels,
+    std::vector<float>& y_accels, bool units) const {
+  rotate_acceleration_impl(acceleration, x_accels, y_accels, units);
+}
+
+template <typename T>
+void stochastic::VlachosEtAl::rotate_acceleration_impl(
+    const std::vector<T>& acceleration, std::vector<T>& x_accels,
+    std::vector<T>& y_accels, bool units) const {
 
   x_accels.resize(acceleration.size());
   y_accels.resize(acceleration.size());
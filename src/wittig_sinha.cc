@@ -1,17 +1,16 @@
 #include <cmath>
 #include <complex>
-#include <ctime>
+#include <stdexcept>
 #include <string>
 // Boost random generator
-#include <boost/random/mersenne_twister.hpp>
 #include <boost/random/normal_distribution.hpp>
-#include <boost/random/variate_generator.hpp>
 // Eigen dense matrices
 #include <Eigen/Dense>
 
 #include "function_dispatcher.h"
 #include "json_object.h"
 #include "numeric_utils.h"
+#include "random_stream.h"
 #include "wittig_sinha.h"
 
 stochastic::WittigSinha::WittigSinha(std::string exposure_category,
@@ -23,6 +22,7 @@ stochastic::WittigSinha::WittigSinha(std::string exposure_category,
       bldg_height_{height},
       num_floors_{num_floors},
       seed_value_{std::numeric_limits<int>::infinity()},
+      stream_seed_{numeric_utils::unique_seed()},
       local_x_{std::vector<double>(1, 1.0)},
       local_y_{std::vector<double>(1, 1.0)},
       freq_cutoff_{5.0},
@@ -65,6 +65,9 @@ stochastic::WittigSinha::WittigSinha(std::string exposure_category,
                   total_time)
 {
   seed_value_ = seed_value;
+  if (seed_value_ != std::numeric_limits<int>::infinity()) {
+    stream_seed_ = static_cast<std::uint64_t>(seed_value_);
+  }
 }
 
 stochastic::WittigSinha::WittigSinha(std::string exposure_category,
@@ -77,6 +80,7 @@ stochastic::WittigSinha::WittigSinha(std::string exposure_category,
       exposure_category_{exposure_category},
       gust_speed_{gust_speed * 0.44704}, // Convert from mph to m/s
       seed_value_{std::numeric_limits<int>::infinity()},
+      stream_seed_{numeric_utils::unique_seed()},
       heights_{heights},
       local_x_{x_locations},
       local_y_{y_locations},
@@ -114,28 +118,58 @@ stochastic::WittigSinha::WittigSinha(std::string exposure_category,
   : WittigSinha(exposure_category, gust_speed, heights, x_locations, y_locations, total_time)
 {
   seed_value_ = seed_value;
+  if (seed_value_ != std::numeric_limits<int>::infinity()) {
+    stream_seed_ = static_cast<std::uint64_t>(seed_value_);
+  }
 }
 
 utilities::JsonObject stochastic::WittigSinha::generate(const std::string& event_name, bool units) {
+  if (precision_ == Precision::Single) {
+    return generate_event<float>(units);
+  }
+
+  return generate_event<double>(units);
+}
+
+template <typename T>
+utilities::JsonObject stochastic::WittigSinha::generate_event(bool units) {
+  typedef Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> Matrix;
+  typedef Eigen::Matrix<std::complex<T>, Eigen::Dynamic, Eigen::Dynamic>
+      ComplexMatrix;
   // Initialize wind velocity vectors
-  std::vector<std::vector<std::vector<std::vector<double>>>> wind_vels(
+  std::vector<std::vector<std::vector<std::vector<T>>>> wind_vels(
       local_x_.size(),
-      std::vector<std::vector<std::vector<double>>>(
+      std::vector<std::vector<std::vector<T>>>(
           local_y_.size(),
-          std::vector<std::vector<double>>(
-              heights_.size(), std::vector<double>(num_times_, 0.0))));
+          std::vector<std::vector<T>>(heights_.size(),
+                                      std::vector<T>(num_times_, T(0)))));
+
+  ComplexMatrix complex_random_vals(num_freqs_, heights_.size());
+
+  // Events in antithetic pairs alternate between drawing new white noise
+  // and negating the white noise of the previous event
+  bool antithetic = antithetic_ && pair_pending_;
+  pair_pending_ = antithetic_ && !pair_pending_;
 
-  Eigen::MatrixXcd complex_random_vals(num_freqs_, heights_.size());
+  // Draw new random streams for each unseeded event
+  if (seed_value_ == std::numeric_limits<int>::infinity() && !antithetic) {
+    stream_seed_ = numeric_utils::unique_seed();
+  }
   
   // Loop over heights to find time histories
   try {
     for (unsigned int i = 0; i < local_x_.size(); ++i) {
       for (unsigned int j = 0; j < local_y_.size(); ++j) {
         // Generate complex random numbers to use for calculation of discrete
-        // time series
-        complex_random_vals = complex_random_numbers();
+        // time series. Cross-spectral density factorization is always done in
+        // double precision.
+        complex_random_vals =
+            complex_random_numbers(i * local_y_.size() + j, antithetic)
+                .template cast<std::complex<T>>();
+        Matrix hists = location_hists<T>(complex_random_vals, units);
         for (unsigned int k = 0; k < heights_.size(); ++k) {
-          wind_vels[i][j][k] = gen_location_hist(complex_random_vals, k, units);
+          Eigen::Matrix<T, Eigen::Dynamic, 1>::Map(wind_vels[i][j][k].data(),
+                                                   num_times_) = hists.col(k);
         }
       }
     }
@@ -208,6 +242,16 @@ bool stochastic::WittigSinha::generate(const std::string& event_name,
   return status;
 }
 
+void stochastic::WittigSinha::set_adaptive_ensemble(EventStatistic statistic,
+                                                    double tolerance,
+                                                    unsigned int min_samples,
+                                                    double confidence) {
+  throw std::runtime_error(
+      "\nERROR: In stochastic::WittigSinha::set_adaptive_ensemble: Adaptive "
+      "ensemble size is not supported, since each call to generate simulates "
+      "a single event\n");
+}
+
 Eigen::MatrixXd stochastic::WittigSinha::cross_spectral_density(double frequency) const {
   // Coefficient for coherence function
   double coherence_coeff = 10.0;
@@ -241,32 +285,29 @@ Eigen::MatrixXd stochastic::WittigSinha::cross_spectral_density(double frequency
   return cross_spectral_density.transpose() + cross_spectral_density - diag_mat;
 }
 
-Eigen::MatrixXcd stochastic::WittigSinha::complex_random_numbers() const {
-  // Construct random number generator for standard normal distribution
-  static unsigned int history_seed = static_cast<unsigned int>(std::time(nullptr));
-  history_seed = history_seed + 10;
-
-  auto generator =
-    seed_value_ != std::numeric_limits<int>::infinity()
-    ? boost::random::mt19937(static_cast<unsigned int>(seed_value_ + 10))
-    : boost::random::mt19937(history_seed);
-  
+Eigen::MatrixXcd stochastic::WittigSinha::complex_random_numbers(
+    unsigned int location_index, bool antithetic) const {
   boost::random::normal_distribution<> distribution;
-  boost::random::variate_generator<boost::random::mt19937&,
-                                   boost::random::normal_distribution<>>
-      distribution_gen(generator, distribution);
 
-  // Generate white noise consisting of complex numbers
+  // Generate white noise consisting of complex numbers. Each height draws from
+  // its own random stream, so locations and heights are independent of the
+  // order in which they are generated.
   Eigen::MatrixXcd white_noise(heights_.size(), num_freqs_);
 
   for (unsigned int i = 0; i < white_noise.rows(); ++i) {
+    numeric_utils::RandomStream noise_stream(stream_seed_, location_index, i);
     for (unsigned int j = 0; j < white_noise.cols(); ++j) {
-      white_noise(i, j) = std::complex<double>(
-          distribution_gen() * std::sqrt(0.5),
-          distribution_gen() * std::sqrt(std::complex<double>(-0.5)).imag());
+      double real_part = distribution(noise_stream) * std::sqrt(0.5);
+      double imag_part = distribution(noise_stream) *
+                         std::sqrt(std::complex<double>(-0.5)).imag();
+      white_noise(i, j) = std::complex<double>(real_part, imag_part);
     }
   }
 
+  if (antithetic) {
+    white_noise = -white_noise;
+  }
+
   // Iterator over all frequencies and generate complex random numbers
   // for discrete time series simulation
   Eigen::MatrixXd cross_spec_density_matrix(heights_.size(), heights_.size());
@@ -306,23 +347,22 @@ std::vector<double> stochastic::WittigSinha::gen_location_hist(
     const Eigen::MatrixXcd& random_numbers, unsigned int column_index,
     bool units) const {
 
-  // This following block implements what is expressed in Equations 7 & 8
-  Eigen::VectorXcd complex_full_range = Eigen::VectorXcd::Zero(2 * num_freqs_);
+  // This following block implements what is expressed in Equations 7 & 8.
+  // Only the non-redundant half of the Hermitian-symmetric spectrum is built,
+  // the complex-to-real transform supplies the conjugate half implicitly
+  Eigen::VectorXcd half_spectrum = Eigen::VectorXcd::Zero(num_freqs_ + 1);
 
-  complex_full_range.segment(1, num_freqs_) =
-      random_numbers.block(0, column_index, num_freqs_, 1);
+  half_spectrum.segment(1, num_freqs_ - 1) =
+      random_numbers.block(0, column_index, num_freqs_ - 1, 1);
 
-  complex_full_range.segment(num_freqs_ + 1, num_freqs_ - 1) =
-      random_numbers.block(0, column_index, num_freqs_ - 1, 1)
-          .reverse()
-          .conjugate();
- 
-  complex_full_range(num_freqs_) = std::abs(random_numbers(num_freqs_ - 1, column_index)); 
+  half_spectrum(num_freqs_) =
+      std::abs(random_numbers(num_freqs_ - 1, column_index));
 
-  // Calculate wind speed using real portion of inverse Fast Fourier Transform
-  // full range of random numbers
-  std::vector<double> node_time_history(complex_full_range.size());
-  numeric_utils::inverse_fft(complex_full_range, node_time_history);
+  // Calculate wind speed using complex-to-real inverse Fast Fourier Transform
+  // of half range of random numbers
+  std::vector<double> node_time_history(2 * num_freqs_);
+  numeric_utils::inverse_fft_c2r(half_spectrum, node_time_history,
+                                 2 * num_freqs_);
 
   // Check if time histories need to be converted to ft/s
   if (units) {
@@ -333,3 +373,48 @@ std::vector<double> stochastic::WittigSinha::gen_location_hist(
   
   return node_time_history;
 }
+
+Eigen::MatrixXd stochastic::WittigSinha::gen_location_hists(
+    const Eigen::MatrixXcd& random_numbers, bool units) const {
+  return location_hists<double>(random_numbers, units);
+}
+
+Eigen::MatrixXf stochastic::WittigSinha::gen_location_hists(
+    const Eigen::MatrixXcf& random_numbers, bool units) const {
+  return location_hists<float>(random_numbers, units);
+}
+
+template <typename T>
+Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic>
+stochastic::WittigSinha::location_hists(
+    const Eigen::Matrix<std::complex<T>, Eigen::Dynamic, Eigen::Dynamic>&
+        random_numbers,
+    bool units) const {
+  typedef Eigen::Matrix<std::complex<T>, Eigen::Dynamic, Eigen::Dynamic>
+      ComplexMatrix;
+
+  // Build half spectra for all locations as in gen_location_hist, with one
+  // column per location
+  ComplexMatrix half_spectra =
+      ComplexMatrix::Zero(num_freqs_ + 1, random_numbers.cols());
+
+  half_spectra.block(1, 0, num_freqs_ - 1, random_numbers.cols()) =
+      random_numbers.topRows(num_freqs_ - 1);
+
+  half_spectra.row(num_freqs_) = random_numbers.row(num_freqs_ - 1)
+                                     .cwiseAbs()
+                                     .template cast<std::complex<T>>();
+
+  // Calculate wind speeds at all locations using single batched
+  // complex-to-real inverse Fast Fourier Transform
+  Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> location_hists;
+  numeric_utils::inverse_fft_c2r_batch(half_spectra, location_hists,
+                                       2 * num_freqs_);
+
+  // Check if time histories need to be converted to ft/s
+  if (units) {
+    location_hists *= T(3.28084);
+  }
+
+  return location_hists;
+}
@@ -0,0 +1,118 @@
+#include <cmath>
+#include <memory>
+#include <catch2/catch.hpp>
+#include <Eigen/Dense>
+#include "baseline_fitter.h"
+#include "numeric_utils.h"
+
+TEST_CASE("Test cached baseline fitter", "[Helpers][BaselineFitter]") {
+  const std::size_t num_points = 400;
+  const double time_step = 0.01;
+  Eigen::VectorXd times(num_points);
+  for (unsigned int i = 0; i < num_points; ++i) {
+    times(i) = i * time_step;
+  }
+
+  // Records with polynomial trends plus oscillations
+  Eigen::MatrixXd records(num_points, 3);
+  for (unsigned int i = 0; i < num_points; ++i) {
+    double t = times(i);
+    records(i, 0) = 0.5 * t * t - 0.2 * std::pow(t, 5) + std::sin(7.0 * t);
+    records(i, 1) = 3.0 * std::pow(t, 3) + 0.1 * std::cos(11.0 * t);
+    records(i, 2) = std::exp(-t) * std::sin(20.0 * t);
+  }
+
+  SECTION("Fitted coefficients match zero-intercept polynomial fit") {
+    numeric_utils::BaselineFitter fitter(num_points, time_step, 5);
+    Eigen::MatrixXd coefficients = fitter.fit(records);
+
+    REQUIRE(coefficients.rows() == 6);
+    REQUIRE(coefficients.cols() == 3);
+    for (unsigned int j = 0; j < records.cols(); ++j) {
+      Eigen::VectorXd record = records.col(j);
+      Eigen::VectorXd expected =
+          numeric_utils::polyfit_intercept(times, record, 0.0, 5);
+      for (unsigned int i = 0; i < expected.size(); ++i) {
+        REQUIRE(coefficients(i, j) ==
+                Approx(expected(i)).epsilon(1e-6).margin(1e-9));
+      }
+    }
+  }
+
+  SECTION("Evaluated derivatives match derivatives of fitted polynomials") {
+    numeric_utils::BaselineFitter fitter(num_points, time_step, 5);
+    Eigen::MatrixXd coefficients = fitter.fit(records);
+
+    for (unsigned int derivative = 0; derivative <= 3; ++derivative) {
+      Eigen::MatrixXd expected = numeric_utils::evaluate_polynomial_batch(
+          coefficients, times, derivative);
+      Eigen::MatrixXd evaluations = fitter.evaluate(records, derivative);
+
+      REQUIRE(evaluations.rows() == num_points);
+      REQUIRE(evaluations.cols() == 3);
+      REQUIRE((evaluations - expected).norm() <=
+              1e-8 * (1.0 + expected.norm()));
+    }
+  }
+
+  SECTION("Polynomial within fitted space is reproduced exactly") {
+    numeric_utils::BaselineFitter fitter(num_points, time_step, 4);
+    Eigen::MatrixXd polynomial(num_points, 1);
+    for (unsigned int i = 0; i < num_points; ++i) {
+      double t = times(i);
+      polynomial(i, 0) = 2.0 * std::pow(t, 4) - t * t;
+    }
+
+    Eigen::MatrixXd coefficients = fitter.fit(polynomial);
+    REQUIRE(coefficients(0, 0) == Approx(2.0).epsilon(1e-8));
+    REQUIRE(coefficients(1, 0) == Approx(0.0).margin(1e-8));
+    REQUIRE(coefficients(2, 0) == Approx(-1.0).epsilon(1e-8));
+    REQUIRE(coefficients(3, 0) == 0.0);
+    REQUIRE(coefficients(4, 0) == 0.0);
+
+    Eigen::MatrixXd second_derivative = fitter.evaluate(polynomial, 2);
+    for (unsigned int i = 0; i < num_points; ++i) {
+      REQUIRE(second_derivative(i, 0) ==
+              Approx(24.0 * times(i) * times(i) - 2.0).margin(1e-7));
+    }
+  }
+
+  SECTION("Invalid fitter configuration or input throws") {
+    REQUIRE_THROWS_AS(numeric_utils::BaselineFitter(num_points, time_step, 1),
+                      std::runtime_error);
+    REQUIRE_THROWS_AS(numeric_utils::BaselineFitter(2, time_step, 5),
+                      std::runtime_error);
+    REQUIRE_THROWS_AS(numeric_utils::BaselineFitter(num_points, 0.0, 5),
+                      std::runtime_error);
+
+    numeric_utils::BaselineFitter fitter(num_points, time_step, 5);
+    REQUIRE_THROWS_AS(fitter.fit(records.topRows(10)), std::runtime_error);
+    REQUIRE_THROWS_AS(fitter.evaluate(records.topRows(10), 2),
+                      std::runtime_error);
+  }
+
+  SECTION("Cache reuses fitters and evicts least recently used") {
+    auto cache = numeric_utils::BaselineFitterCache::instance();
+    cache->clear();
+    std::size_t original_capacity = cache->capacity();
+
+    auto first = cache->fitter(num_points, time_step, 5);
+    auto second = cache->fitter(num_points, time_step, 5);
+    REQUIRE(first == second);
+    REQUIRE(cache->size() == 1);
+
+    auto other = cache->fitter(num_points / 2, time_step, 5);
+    REQUIRE(other != first);
+    REQUIRE(other->num_points() == num_points / 2);
+    REQUIRE(cache->size() == 2);
+
+    cache->set_capacity(1);
+    REQUIRE(cache->size() == 1);
+    REQUIRE(cache->fitter(num_points / 2, time_step, 5) == other);
+    REQUIRE(first->fit(records).rows() == 6);
+
+    cache->set_capacity(original_capacity);
+    cache->clear();
+    REQUIRE(cache->size() == 0);
+  }
+}
@@ -1,7 +1,11 @@
+#include <algorithm>
 #include <cmath>
+#include <memory>
+#include <type_traits>
 #include <vector>
 #include <catch2/catch.hpp>
 #include <Eigen/Dense>
+#include "beta_dist.h"
 #include "factory.h"
 #include "normal_dist.h"
 
@@ -113,4 +117,98 @@ TEST_CASE("Test different distribution types", "[Distributions]") {
     REQUIRE(probabilities[2] == Approx(1.0).epsilon(0.01));
     REQUIRE(calced_locations[2] == Approx(1.0).epsilon(0.01));
   }
+
+  SECTION("Test in place transformation from standard normal space") {
+    auto normal = Factory<stochastic::Distribution, double, double>::instance()
+                      ->create("NormalDist", 0.0, 1.0);
+    std::vector<std::shared_ptr<stochastic::Distribution>> distributions = {
+        Factory<stochastic::Distribution, double, double>::instance()->create(
+            "NormalDist", 1.5, 0.3),
+        Factory<stochastic::Distribution, double, double>::instance()->create(
+            "LognormalDist", 0.5, 0.25),
+        Factory<stochastic::Distribution, double, double>::instance()->create(
+            "UniformDist", -2.0, 3.0),
+        Factory<stochastic::Distribution, double, double>::instance()->create(
+            "BetaDist", 2.0, 5.0),
+        Factory<stochastic::Distribution, double, double>::instance()->create(
+            "InverseGaussianDist", 2.0, 1.0),
+        Factory<stochastic::Distribution, double, double, double>::instance()
+            ->create("StudentstDist", 1.0, 2.0, 4.0)};
+
+    Eigen::MatrixXd normal_values(3, 4);
+    // clang-format off
+    normal_values << -3.0, -1.2, 0.0, 0.4,
+                     -0.1, 0.7, 1.9, 3.5,
+                     2.2, -2.4, 0.05, -0.6;
+    // clang-format on
+
+    for (auto const& distribution : distributions) {
+      // Transform whole matrix, a single column and a single row
+      Eigen::MatrixXd matrix_values = normal_values;
+      distribution->transform_from_std_normal(matrix_values);
+      Eigen::MatrixXd column_values = normal_values;
+      distribution->transform_from_std_normal(column_values.col(2));
+      Eigen::MatrixXd row_values = normal_values;
+      distribution->transform_from_std_normal(row_values.row(1));
+
+      for (unsigned int i = 0; i < normal_values.rows(); ++i) {
+        for (unsigned int j = 0; j < normal_values.cols(); ++j) {
+          double expected = distribution->inv_cumulative_dist_func(
+              normal->cumulative_dist_func({normal_values(i, j)}))[0];
+          REQUIRE(matrix_values(i, j) == Approx(expected).epsilon(1.0e-8));
+          REQUIRE(column_values(i, j) ==
+                  (j == 2 ? matrix_values(i, j) : normal_values(i, j)));
+          REQUIRE(row_values(i, j) ==
+                  (i == 1 ? matrix_values(i, j) : normal_values(i, j)));
+        }
+      }
+    }
+  }
+
+  SECTION("Test tabulated transformation from standard normal space") {
+    auto normal = Factory<stochastic::Distribution, double, double>::instance()
+                      ->create("NormalDist", 1.5, 0.3);
+    REQUIRE(!normal->build_quantile_table());
+
+    // Tables refer to the distribution they were built for
+    REQUIRE(!std::is_copy_constructible<stochastic::BetaDistribution>::value);
+    REQUIRE(!std::is_copy_assignable<stochastic::BetaDistribution>::value);
+
+    auto create = []() {
+      return std::vector<std::shared_ptr<stochastic::Distribution>>{
+          Factory<stochastic::Distribution, double, double>::instance()
+              ->create("BetaDist", 2.0, 5.0),
+          Factory<stochastic::Distribution, double, double>::instance()
+              ->create("BetaDist", 0.7, 1.3),
+          Factory<stochastic::Distribution, double, double>::instance()
+              ->create("InverseGaussianDist", 0.35, 0.17),
+          Factory<stochastic::Distribution, double, double, double>::instance()
+              ->create("StudentstDist", 1.0, 2.0, 4.0)};
+    };
+    auto tabulated = create();
+    auto exact = create();
+
+    // Grid extends past tabulated range to check exact fallback in tails
+    const unsigned int num_values = 1401;
+    Eigen::MatrixXd normal_values(1, num_values);
+    for (unsigned int i = 0; i < num_values; ++i) {
+      normal_values(0, i) = -7.0 + 0.01 * i;
+    }
+
+    const double tolerance = 1.0e-9;
+    for (unsigned int i = 0; i < tabulated.size(); ++i) {
+      REQUIRE(tabulated[i]->build_quantile_table(tolerance));
+
+      Eigen::MatrixXd table_values = normal_values;
+      tabulated[i]->transform_from_std_normal(table_values);
+      Eigen::MatrixXd exact_values = normal_values;
+      exact[i]->transform_from_std_normal(exact_values);
+
+      for (unsigned int j = 0; j < num_values; ++j) {
+        REQUIRE(std::abs(table_values(0, j) - exact_values(0, j)) <=
+                10.0 * tolerance *
+                    std::max(1.0, std::abs(exact_values(0, j))));
+      }
+    }
+  }
 }
@@ -0,0 +1,229 @@
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <memory>
+#include <string>
+#include <vector>
+#include <catch2/catch.hpp>
+#include "fft_backend.h"
+#include "fft_plan.h"
+#include "native_fft.h"
+#include "numeric_utils.h"
+
+namespace {
+// Reference discrete Fourier transform computed by direct summation
+std::vector<std::complex<double>> reference_dft(
+    const std::vector<std::complex<double>>& input, double sign) {
+  const double pi = std::acos(-1.0);
+  std::size_t length = input.size();
+  std::vector<std::complex<double>> output(length);
+  for (std::size_t k = 0; k < length; ++k) {
+    for (std::size_t j = 0; j < length; ++j) {
+      output[k] += input[j] * std::polar(1.0, sign * 2.0 * pi *
+                                                   ((j * k) % length) / length);
+    }
+  }
+  return output;
+}
+
+std::vector<double> test_signal(std::size_t length) {
+  std::vector<double> signal(length);
+  for (std::size_t i = 0; i < length; ++i) {
+    signal[i] = std::sin(0.3 * i) + 0.25 * std::cos(1.7 * i) + 0.1 * i;
+  }
+  return signal;
+}
+}  // namespace
+
+TEST_CASE("Test native FFT backend", "[Helpers][FFT]") {
+  numeric_utils::NativeFftBackend backend;
+
+  SECTION("Complex transforms match direct summation for all radices") {
+    // Powers of 2, mixed radix, generic radix and Bluestein lengths
+    for (std::size_t length : {1, 2, 8, 12, 15, 30, 49, 64, 77, 101, 202}) {
+      auto signal = test_signal(length);
+      std::vector<std::complex<double>> input(length);
+      for (std::size_t i = 0; i < length; ++i) {
+        input[i] = std::complex<double>(signal[i], 0.5 - signal[i]);
+      }
+      auto expected = reference_dft(input, -1.0);
+
+      auto forward = backend.create_plan(
+          length, numeric_utils::FftDirection::Forward,
+          numeric_utils::FftDomain::Complex, numeric_utils::FftLayout(),
+          numeric_utils::FftPrecision::Double);
+      std::vector<std::complex<double>> output(length);
+      forward->compute(input.data(), output.data());
+
+      double max_error = 0.0;
+      for (std::size_t i = 0; i < length; ++i) {
+        max_error = std::max(max_error, std::abs(output[i] - expected[i]));
+      }
+      REQUIRE(max_error == Approx(0.0).margin(1.0e-9));
+
+      auto backward = backend.create_plan(
+          length, numeric_utils::FftDirection::Backward,
+          numeric_utils::FftDomain::Complex, numeric_utils::FftLayout(),
+          numeric_utils::FftPrecision::Double);
+      std::vector<std::complex<double>> recovered(length);
+      backward->compute(output.data(), recovered.data());
+
+      max_error = 0.0;
+      for (std::size_t i = 0; i < length; ++i) {
+        max_error = std::max(max_error, std::abs(recovered[i] - input[i]));
+      }
+      REQUIRE(max_error == Approx(0.0).margin(1.0e-10));
+    }
+  }
+
+  SECTION("Real transforms of even and odd length round trip") {
+    for (std::size_t length : {1, 2, 6, 9, 20, 97, 1000, 1006}) {
+      auto signal = test_signal(length);
+      std::vector<std::complex<double>> input(signal.begin(), signal.end());
+      auto expected = reference_dft(input, -1.0);
+
+      auto forward = backend.create_plan(
+          length, numeric_utils::FftDirection::Forward,
+          numeric_utils::FftDomain::Real, numeric_utils::FftLayout(),
+          numeric_utils::FftPrecision::Double);
+      std::vector<std::complex<double>> spectrum(length / 2 + 1);
+      forward->compute(signal.data(), spectrum.data());
+
+      double max_error = 0.0;
+      for (std::size_t k = 0; k < spectrum.size(); ++k) {
+        max_error = std::max(max_error, std::abs(spectrum[k] - expected[k]));
+      }
+      REQUIRE(max_error == Approx(0.0).margin(1.0e-8));
+
+      auto backward = backend.create_plan(
+          length, numeric_utils::FftDirection::Backward,
+          numeric_utils::FftDomain::Real, numeric_utils::FftLayout(),
+          numeric_utils::FftPrecision::Double);
+      std::vector<double> output(length);
+      backward->compute(spectrum.data(), output.data());
+
+      max_error = 0.0;
+      for (std::size_t i = 0; i < length; ++i) {
+        max_error = std::max(max_error, std::abs(output[i] - signal[i]));
+      }
+      REQUIRE(max_error == Approx(0.0).margin(1.0e-10));
+    }
+  }
+
+  SECTION("Batched, strided and in-place layouts") {
+    // Two interleaved signals of length 6
+    std::vector<double> input = {3.0, 0.0, 1.0, 0.0, 0.0, 3.0,
+                                 0.0, 1.0, 2.0, 0.0, 0.0, 0.0};
+    auto plan = backend.create_plan(
+        6, numeric_utils::FftDirection::Forward,
+        numeric_utils::FftDomain::Real, numeric_utils::FftLayout(2, 2, 1, 1, 4),
+        numeric_utils::FftPrecision::Double);
+    std::vector<std::complex<double>> spectra(8);
+    plan->compute(input.data(), spectra.data());
+
+    for (std::size_t signal = 0; signal < 2; ++signal) {
+      std::vector<std::complex<double>> values(6);
+      for (std::size_t i = 0; i < 6; ++i) {
+        values[i] = input[2 * i + signal];
+      }
+      auto expected = reference_dft(values, -1.0);
+      for (std::size_t k = 0; k < 4; ++k) {
+        REQUIRE(std::abs(spectra[4 * signal + k] - expected[k]) ==
+                Approx(0.0).margin(1.0e-10));
+      }
+    }
+
+    // In-place real transform of padded buffer
+    std::vector<double> buffer = {1.0, 2.0, 3.0, 4.0, 5.0, 0.0};
+    auto in_place = backend.create_plan(
+        5, numeric_utils::FftDirection::Forward,
+        numeric_utils::FftDomain::Real,
+        numeric_utils::FftLayout(1, 1, 0, 1, 0, true),
+        numeric_utils::FftPrecision::Double);
+    in_place->compute(buffer.data(), nullptr);
+    REQUIRE(buffer[0] == Approx(15.0));
+    REQUIRE(buffer[2] == Approx(-2.5));
+    REQUIRE(buffer[3] == Approx(3.440954801177933));
+  }
+
+  SECTION("Single precision transforms") {
+    std::vector<float> input = {3.0f, 1.0f, 0.0f, 0.0f};
+    auto plan = backend.create_plan(
+        4, numeric_utils::FftDirection::Forward,
+        numeric_utils::FftDomain::Real, numeric_utils::FftLayout(),
+        numeric_utils::FftPrecision::Single);
+    std::vector<std::complex<float>> output(3);
+    plan->compute(input.data(), output.data());
+
+    REQUIRE(output[0].real() == Approx(4.0));
+    REQUIRE(output[1].real() == Approx(3.0));
+    REQUIRE(output[1].imag() == Approx(-1.0));
+    REQUIRE(output[2].real() == Approx(2.0));
+  }
+
+  SECTION("Direct convolution") {
+    std::vector<double> input_x = {1.0, 2.0, 3.0};
+    std::vector<double> input_y = {0.0, 1.0, 0.5};
+    std::vector<double> response(5);
+    backend.convolve(input_x.data(), 3, input_y.data(), 3, response.data());
+
+    std::vector<double> expected = {0.0, 1.0, 2.5, 4.0, 1.5};
+    for (std::size_t i = 0; i < response.size(); ++i) {
+      REQUIRE(response[i] == Approx(expected[i]).margin(1.0e-12));
+    }
+  }
+}
+
+TEST_CASE("Test FFT backend selection", "[Helpers][FFT]") {
+  auto initial_backend = numeric_utils::fft_backend()->name();
+  auto backends = numeric_utils::fft_backends();
+
+  SECTION("Unknown backends are rejected") {
+    REQUIRE_THROWS_AS(numeric_utils::set_fft_backend("NotABackend"),
+                      std::runtime_error);
+    REQUIRE(numeric_utils::fft_backend()->name() == initial_backend);
+  }
+
+  SECTION("All backends produce the same transforms and convolutions") {
+    auto signal = test_signal(1000);
+    std::vector<double> kernel = {0.25, 0.5, 0.25, -0.125};
+
+    std::vector<std::vector<std::complex<double>>> spectra;
+    std::vector<std::vector<double>> responses;
+    for (const auto& backend : backends) {
+      numeric_utils::set_fft_backend(backend);
+      REQUIRE(numeric_utils::fft_backend()->name() == backend);
+
+      auto plan = numeric_utils::FftPlanCache::instance()->plan(
+          signal.size(), numeric_utils::FftDirection::Forward,
+          numeric_utils::FftDomain::Real);
+      REQUIRE(plan->backend() == backend);
+
+      std::vector<std::complex<double>> spectrum;
+      numeric_utils::fft(signal, spectrum);
+      spectra.push_back(spectrum);
+
+      std::vector<double> response;
+      numeric_utils::convolve_1d(signal, kernel, response,
+                                 numeric_utils::ConvolutionMode::Direct);
+      responses.push_back(response);
+    }
+
+    for (std::size_t i = 1; i < backends.size(); ++i) {
+      double max_error = 0.0;
+      for (std::size_t k = 0; k < spectra[0].size(); ++k) {
+        max_error = std::max(max_error, std::abs(spectra[i][k] - spectra[0][k]));
+      }
+      REQUIRE(max_error == Approx(0.0).margin(1.0e-8));
+
+      max_error = 0.0;
+      for (std::size_t k = 0; k < responses[0].size(); ++k) {
+        max_error =
+            std::max(max_error, std::abs(responses[i][k] - responses[0][k]));
+      }
+      REQUIRE(max_error == Approx(0.0).margin(1.0e-12));
+    }
+  }
+
+  numeric_utils::set_fft_backend(initial_backend);
+}
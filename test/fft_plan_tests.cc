@@ -0,0 +1,124 @@
+#include <complex>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <catch2/catch.hpp>
+#include "fft_plan.h"
+#include "numeric_utils.h"
+
+TEST_CASE("Test cached FFT plans", "[Helpers][FFT]") {
+  SECTION("Forward complex plan matches known transform") {
+    numeric_utils::FftPlan plan(4, numeric_utils::FftDirection::Forward,
+                                numeric_utils::FftDomain::Complex);
+    std::vector<std::complex<double>> input = {
+        {3.0, 0.0}, {1.0, 0.0}, {0.0, 0.0}, {0.0, 0.0}};
+    std::vector<std::complex<double>> output(4);
+    plan.execute(input.data(), output.data());
+
+    REQUIRE(plan.length() == 4);
+    REQUIRE(real(output[0]) == Approx(4.0).epsilon(0.01));
+    REQUIRE(real(output[1]) == Approx(3.0).epsilon(0.01));
+    REQUIRE(imag(output[1]) == Approx(-1.0).epsilon(0.01));
+    REQUIRE(real(output[2]) == Approx(2.0).epsilon(0.01));
+    REQUIRE(real(output[3]) == Approx(3.0).epsilon(0.01));
+    REQUIRE(imag(output[3]) == Approx(1.0).epsilon(0.01));
+  }
+
+  SECTION("Backward real plan inverts half spectrum") {
+    numeric_utils::FftPlan plan(5, numeric_utils::FftDirection::Backward,
+                                numeric_utils::FftDomain::Real);
+    std::vector<std::complex<double>> input = {
+        {15.0, 0.0}, {-2.5, 3.440954801177933}, {-2.5, 0.812299240582266}};
+    std::vector<double> output(5);
+    plan.execute(input.data(), output.data());
+
+    for (unsigned int i = 0; i < output.size(); ++i) {
+      REQUIRE(output[i] == Approx(i + 1.0).epsilon(0.01));
+    }
+  }
+
+  SECTION("Executing plan with mismatched types throws") {
+    numeric_utils::FftPlan plan(4, numeric_utils::FftDirection::Forward,
+                                numeric_utils::FftDomain::Complex);
+    std::vector<double> input(4, 1.0);
+    std::vector<std::complex<double>> output(4);
+    REQUIRE_THROWS_AS(plan.execute(input.data(), output.data()),
+                      std::runtime_error);
+    REQUIRE_THROWS_AS(numeric_utils::FftPlan(
+                          0, numeric_utils::FftDirection::Forward,
+                          numeric_utils::FftDomain::Complex),
+                      std::runtime_error);
+  }
+
+  SECTION("In-place plan overwrites input and rejects separate output") {
+    numeric_utils::FftPlan plan(4, numeric_utils::FftDirection::Forward,
+                                numeric_utils::FftDomain::Complex,
+                                numeric_utils::FftLayout(1, 1, 0, 1, 0, true));
+    std::vector<std::complex<double>> data = {
+        {3.0, 0.0}, {1.0, 0.0}, {0.0, 0.0}, {0.0, 0.0}};
+    plan.execute(data.data());
+
+    REQUIRE(real(data[1]) == Approx(3.0).epsilon(0.01));
+    REQUIRE(imag(data[1]) == Approx(-1.0).epsilon(0.01));
+
+    std::vector<std::complex<double>> output(4);
+    REQUIRE_THROWS_AS(plan.execute(data.data(), output.data()),
+                      std::runtime_error);
+
+    numeric_utils::FftPlan out_of_place(4, numeric_utils::FftDirection::Forward,
+                                        numeric_utils::FftDomain::Complex);
+    REQUIRE_THROWS_AS(out_of_place.execute(data.data()), std::runtime_error);
+  }
+
+  SECTION("Cache reuses plans and respects capacity") {
+    auto cache = numeric_utils::FftPlanCache::instance();
+    cache->clear();
+    auto initial_capacity = cache->capacity();
+
+    auto first = cache->plan(8, numeric_utils::FftDirection::Forward,
+                             numeric_utils::FftDomain::Complex);
+    auto second = cache->plan(8, numeric_utils::FftDirection::Forward,
+                              numeric_utils::FftDomain::Complex);
+    auto backward = cache->plan(8, numeric_utils::FftDirection::Backward,
+                                numeric_utils::FftDomain::Complex);
+    REQUIRE(first == second);
+    REQUIRE(first != backward);
+    REQUIRE(cache->size() == 2);
+
+    cache->set_capacity(2);
+    auto other = cache->plan(16, numeric_utils::FftDirection::Forward,
+                             numeric_utils::FftDomain::Complex);
+    REQUIRE(cache->size() == 2);
+    // Least recently used plan was evicted but is still valid for holders
+    auto refetched = cache->plan(8, numeric_utils::FftDirection::Forward,
+                                 numeric_utils::FftDomain::Complex);
+    REQUIRE(refetched != first);
+    REQUIRE(first->length() == 8);
+
+    cache->set_capacity(initial_capacity);
+    cache->clear();
+    REQUIRE(cache->size() == 0);
+  }
+
+  SECTION("Cached plans can be shared between threads") {
+    std::vector<double> input = {3.0, 1.0, 0.0, 0.0};
+    std::vector<std::vector<std::complex<double>>> outputs(4);
+    std::vector<std::thread> threads;
+
+    for (unsigned int i = 0; i < outputs.size(); ++i) {
+      threads.emplace_back([&input, &outputs, i]() {
+        for (unsigned int j = 0; j < 50; ++j) {
+          numeric_utils::fft(input, outputs[i]);
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    for (const auto& output : outputs) {
+      REQUIRE(real(output[1]) == Approx(3.0).epsilon(0.01));
+      REQUIRE(imag(output[1]) == Approx(-1.0).epsilon(0.01));
+    }
+  }
+}